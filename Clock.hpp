@@ -0,0 +1,88 @@
+#pragma once
+// Clock.hpp -- per-frame animation clock with a virtual mode, zero SDL dependency.
+//
+// Application::loop calls tick() once per frame, after events are drained.
+// Everything time based (interpolators, toasts, marquees, cursor blink,
+// timers) reads now*() so all animations in one frame see the same
+// timestamp. In virtual mode time only moves through advance(), which lets
+// tests and benchmarks step or fast-forward animations.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Volt {
+
+	class Clock {
+	public:
+		static Clock& Get()
+		{
+			static Clock instance;
+			return instance;
+		}
+
+		Clock(const Clock&) = delete;
+		Clock(Clock&&) = delete;
+
+		// gui thread, once per frame
+		void tick()
+		{
+			const uint64_t now = sample();
+			const uint64_t prev = now_ns_.exchange(now, std::memory_order_relaxed);
+			delta_ns_ = now > prev ? now - prev : 0;
+			++frame_;
+		}
+
+		// frame timestamp, ns since the clock started
+		uint64_t nowNs() const { return now_ns_.load(std::memory_order_relaxed); }
+		uint64_t nowMs() const { return nowNs() / 1000000; }
+		double nowSeconds() const { return static_cast<double>(nowNs()) / 1e9; }
+
+		// time between the last two ticks
+		uint64_t deltaNs() const { return delta_ns_; }
+
+		uint64_t frame() const { return frame_; }
+
+		// Current time without waiting for the next tick: the real clock, or the
+		// virtual time in virtual mode. For scheduling, not for animation.
+		uint64_t sample() const
+		{
+			if (virtual_.load(std::memory_order_relaxed))
+				return virtual_ns_.load(std::memory_order_relaxed);
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - origin_).count());
+		}
+
+		// Entering virtual mode freezes time at the current frame timestamp,
+		// leaving it jumps back to real time.
+		Clock& setVirtual(bool enabled)
+		{
+			if (enabled && !virtual_.load(std::memory_order_relaxed))
+				virtual_ns_.store(nowNs(), std::memory_order_relaxed);
+			virtual_.store(enabled, std::memory_order_relaxed);
+			return *this;
+		}
+
+		bool isVirtual() const { return virtual_.load(std::memory_order_relaxed); }
+
+		// virtual mode only, seen by the next tick()
+		Clock& advance(uint64_t ns)
+		{
+			virtual_ns_.fetch_add(ns, std::memory_order_relaxed);
+			return *this;
+		}
+
+		Clock& advanceMs(uint64_t ms) { return advance(ms * 1000000); }
+
+	private:
+		Clock() : origin_(std::chrono::steady_clock::now()) {}
+
+		std::chrono::steady_clock::time_point origin_;
+		std::atomic<uint64_t> now_ns_{ 0 };
+		std::atomic<uint64_t> virtual_ns_{ 0 };
+		std::atomic<bool> virtual_{ false };
+		uint64_t delta_ns_ = 0;
+		uint64_t frame_ = 0;
+	};
+
+} // namespace Volt
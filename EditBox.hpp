@@ -82,6 +82,8 @@
 			IView::type = "editbox";
 			attr_ = attr;
 			bounds = attr.rect;
+			markGeometryDirty();
+			updateEventMask();
 
 			text_rect_ = {
 				bounds.x + to_cust(attr.margin.x, bounds.w),
@@ -171,7 +173,7 @@
 		}
 		std::string getText() const { return model_.text(); }
 
-		EditBox& setOnFocusView(IView* v) { on_focus_view_ = v; return *this; }
+		EditBox& setOnFocusView(IView* v) { on_focus_view_ = v; updateEventMask(); return *this; }
 		IView* getOnFocusView() { return on_focus_view_; }
 		bool isActive() const { return has_focus_; }
 
@@ -256,6 +258,11 @@
 		EditBox& setOutlineColor(const SDL_Color& c) { outline_rect_.outline_color = c; outline_color_ = c; return *this; }
 
 	protected:
+		// pointers to take focus, keys and text to edit; an on focus view gets everything passed on
+		void updateEventMask() {
+			subscribeEvents(on_focus_view_ ? EVC_ALL : EVC_POINTER | EVC_KEYBOARD | EVC_TEXT_INPUT | EVC_WINDOW | EVC_RENDER_RESET);
+		}
+
 		template <typename T>
 		bool onClick(T x, T y, unsigned short axis = 0) {
 			if (axis == 0) [[likely]] {
@@ -302,7 +309,6 @@
 				bool already_focused = has_focus_;
 				has_focus_ = true;
 				if (!already_focused) {
-					adaptive_vsync_handler_.startRedrawSession();
 					SDL_StartTextInput(window);
 					if (on_focus_view_) on_focus_view_->show();
 				}
@@ -330,7 +336,7 @@
 			const bool shift = (event->key.mod & SDL_KMOD_SHIFT) != 0;
 			const bool cmd = (event->key.mod & (SDL_KMOD_CTRL | SDL_KMOD_GUI)) != 0;
 
-			cursor_.m_start = SDL_GetTicks(); // any key activity resets the blink phase
+			cursor_.m_start = Volt::Clock::Get().nowMs(); // any key activity resets the blink phase
 
 			if (sc == SDL_SCANCODE_AC_BACK) {
 				killFocus();
@@ -429,6 +435,7 @@
 				outline_rect_.handleEvent();
 
 				bounds = { next_x, next_y, next_w, next_h };
+				markGeometryDirty();
 
 				text_rect_ = {
 				DisplayInfo::Get().toUpdatedWidth(text_rect_.x),
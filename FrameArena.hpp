@@ -0,0 +1,185 @@
+#pragma once
+// FrameArena.hpp -- per-frame bump allocator for transient UI thread data, zero SDL dependency.
+//
+// A std::pmr::memory_resource handing out memory by bumping a pointer through
+// a chunk that is rewound after every present, so per-frame scratch
+// containers cost no heap allocation once the first frames have sized the
+// arena. Only the thread the arena is bound to (the UI thread) bumps; any
+// other caller silently gets the upstream heap, so a pmr container handed
+// the arena stays safe to use from a worker. Nothing allocated from it may
+// outlive the frame.
+//
+//	Volt::FrameVector<SDL_Texture*> row{ Volt::FrameArena::Get().resource() };
+//
+// Heap allocations are counted per frame when one translation unit defines
+// VOLT_COUNT_ALLOCATIONS before including volt.h; that installs a global
+// operator new replacement feeding Volt::HeapCounter.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Volt {
+
+	struct HeapCounter {
+		static std::atomic<uint64_t>& allocs()
+		{
+			static std::atomic<uint64_t> count{ 0 };
+			return count;
+		}
+
+		static std::atomic<uint64_t>& bytes()
+		{
+			static std::atomic<uint64_t> count{ 0 };
+			return count;
+		}
+
+		static void record(std::size_t size)
+		{
+			allocs().fetch_add(1, std::memory_order_relaxed);
+			bytes().fetch_add(size, std::memory_order_relaxed);
+		}
+	};
+
+	class FrameArena : public std::pmr::memory_resource {
+	public:
+		static constexpr std::size_t DefaultChunkBytes = 64 * 1024;
+
+		static FrameArena& Get()
+		{
+			static FrameArena instance;
+			return instance;
+		}
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena(FrameArena&&) = delete;
+
+		~FrameArena() override
+		{
+			for (auto& c : chunks_)
+				std::pmr::new_delete_resource()->deallocate(c.data, c.size, alignof(std::max_align_t));
+		}
+
+		// the UI thread, before the first frame
+		void bindToCurrentThread() { owner_ = std::this_thread::get_id(); }
+
+		std::pmr::memory_resource* resource() { return this; }
+
+		// After present. Rewinds everything; when the frame needed more than
+		// one chunk they are merged into one big enough for it, so the next
+		// frame of the same shape fits without touching the heap.
+		void endFrame()
+		{
+			const uint64_t allocs = HeapCounter::allocs().load(std::memory_order_relaxed);
+			last_frame_heap_allocs_ = allocs - frame_start_allocs_;
+			frame_start_allocs_ = allocs;
+			last_frame_bytes_ = used_;
+			high_water_ = std::max(high_water_, used_);
+			if (chunks_.size() > 1) {
+				std::size_t total = 0;
+				for (auto& c : chunks_) {
+					total += c.size;
+					std::pmr::new_delete_resource()->deallocate(c.data, c.size, alignof(std::max_align_t));
+				}
+				chunks_.clear();
+				addChunk(total);
+			}
+			current_ = 0;
+			offset_ = 0;
+			used_ = 0;
+		}
+
+		// heap allocations, all threads, between the last two endFrame() calls;
+		// always 0 unless VOLT_COUNT_ALLOCATIONS (or VoltBench) counts them
+		uint64_t lastFrameHeapAllocs() const { return last_frame_heap_allocs_; }
+		std::size_t lastFrameBytes() const { return last_frame_bytes_; }
+		std::size_t highWaterBytes() const { return high_water_; }
+		std::size_t capacity() const
+		{
+			std::size_t total = 0;
+			for (const auto& c : chunks_) total += c.size;
+			return total;
+		}
+
+	private:
+		struct Chunk {
+			std::byte* data = nullptr;
+			std::size_t size = 0;
+		};
+
+		FrameArena() { addChunk(DefaultChunkBytes); }
+
+		void addChunk(std::size_t size)
+		{
+			chunks_.push_back({ static_cast<std::byte*>(std::pmr::new_delete_resource()->allocate(size, alignof(std::max_align_t))), size });
+		}
+
+		bool owns(const void* p) const
+		{
+			for (const auto& c : chunks_)
+				if (p >= c.data and p < c.data + c.size) return true;
+			return false;
+		}
+
+		void* do_allocate(std::size_t bytes, std::size_t align) override
+		{
+			if (std::this_thread::get_id() != owner_)
+				return std::pmr::new_delete_resource()->allocate(bytes, align);
+			for (;;) {
+				Chunk& c = chunks_[current_];
+				const std::size_t start = (offset_ + align - 1) & ~(align - 1);
+				if (start + bytes <= c.size) {
+					offset_ = start + bytes;
+					used_ += bytes;
+					return c.data + start;
+				}
+				if (current_ + 1 == chunks_.size())
+					addChunk(std::max(bytes + align, c.size * 2));
+				++current_;
+				offset_ = 0;
+			}
+		}
+
+		// bump memory comes back with endFrame(), only foreign blocks are freed here
+		void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+		{
+			if (not owns(p))
+				std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		std::vector<Chunk> chunks_;
+		std::size_t current_ = 0, offset_ = 0, used_ = 0;
+		std::size_t last_frame_bytes_ = 0, high_water_ = 0;
+		uint64_t frame_start_allocs_ = 0, last_frame_heap_allocs_ = 0;
+		std::thread::id owner_{};
+	};
+
+	template <typename T>
+	using FrameVector = std::pmr::vector<T>;
+	using FrameString = std::pmr::string;
+
+} // namespace Volt
+
+#ifdef VOLT_COUNT_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+	Volt::HeapCounter::record(size);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // VOLT_COUNT_ALLOCATIONS
@@ -0,0 +1,189 @@
+#pragma once
+// Function.hpp -- allocation-free callables for widget callbacks, zero SDL dependency.
+//
+// InplaceFunction<Sig, N> is a copyable std::function replacement that keeps
+// the callable inside an N byte buffer: storing one never allocates, and a
+// capture that doesn't fit is a compile error, not a silent heap fallback.
+//
+//	Volt::InplaceFunction<void(Cell&)> cb = [this, &cell](Cell& c) { ... };
+//
+// FunctionRef<Sig> is a non-owning view of a callable for callbacks that are
+// only invoked before the call taking them returns; the callable must
+// outlive the FunctionRef.
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Volt {
+
+	namespace detail {
+		template <typename T>
+		struct IsStdFunction : std::false_type {};
+		template <typename Sig>
+		struct IsStdFunction<std::function<Sig>> : std::true_type {};
+
+		// callables that can be "empty", stored as an empty InplaceFunction then
+		template <typename F>
+		bool isNullCallable(const F& f)
+		{
+			if constexpr (std::is_pointer_v<F> or std::is_member_pointer_v<F> or IsStdFunction<F>::value)
+				return f == nullptr;
+			else
+				return false;
+		}
+	}
+
+	// six pointers, room for [this, &a, &b] style captures or a std::function
+	inline constexpr std::size_t DefaultCallbackCapacity = 6 * sizeof(void*);
+
+	template <typename Sig, std::size_t Capacity = DefaultCallbackCapacity>
+	class InplaceFunction;
+
+	template <typename R, typename... Args, std::size_t Capacity>
+	class InplaceFunction<R(Args...), Capacity> {
+	public:
+		static constexpr std::size_t capacity = Capacity;
+
+		InplaceFunction() noexcept = default;
+		InplaceFunction(std::nullptr_t) noexcept {}
+
+		template <typename F>
+			requires(not std::is_same_v<std::decay_t<F>, InplaceFunction> and std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+		InplaceFunction(F&& f)
+		{
+			using Fn = std::decay_t<F>;
+			static_assert(sizeof(Fn) <= Capacity, "callback capture doesn't fit the InplaceFunction buffer, capture less or raise its capacity");
+			static_assert(alignof(Fn) <= alignof(std::max_align_t), "over-aligned callback capture");
+			static_assert(std::is_copy_constructible_v<Fn>, "InplaceFunction callbacks must be copyable");
+			if (detail::isNullCallable(f))
+				return;
+			::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+			ops_ = &OpsFor<Fn>;
+		}
+
+		InplaceFunction(const InplaceFunction& other)
+		{
+			if (other.ops_) {
+				other.ops_->copy(storage_, other.storage_);
+				ops_ = other.ops_;
+			}
+		}
+
+		InplaceFunction(InplaceFunction&& other) noexcept
+		{
+			if (other.ops_) {
+				other.ops_->move(storage_, other.storage_);
+				ops_ = other.ops_;
+				other.reset();
+			}
+		}
+
+		InplaceFunction& operator=(const InplaceFunction& other)
+		{
+			if (this != &other) {
+				InplaceFunction tmp(other);
+				*this = std::move(tmp);
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(InplaceFunction&& other) noexcept
+		{
+			if (this != &other) {
+				reset();
+				if (other.ops_) {
+					other.ops_->move(storage_, other.storage_);
+					ops_ = other.ops_;
+					other.reset();
+				}
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(std::nullptr_t) noexcept
+		{
+			reset();
+			return *this;
+		}
+
+		~InplaceFunction() { reset(); }
+
+		explicit operator bool() const noexcept { return ops_ != nullptr; }
+		friend bool operator==(const InplaceFunction& f, std::nullptr_t) noexcept { return f.ops_ == nullptr; }
+
+		// like std::function, calling an empty one throws
+		R operator()(Args... args) const
+		{
+			if (not ops_)
+				throw std::bad_function_call();
+			return ops_->invoke(storage_, std::forward<Args>(args)...);
+		}
+
+	private:
+		struct Ops {
+			R (*invoke)(void*, Args&&...);
+			void (*copy)(void* dst, const void* src);
+			void (*move)(void* dst, void* src) noexcept;
+			void (*destroy)(void*) noexcept;
+		};
+
+		template <typename Fn>
+		static constexpr Ops OpsFor = {
+			[](void* self, Args&&... args) -> R { return std::invoke(*static_cast<Fn*>(self), std::forward<Args>(args)...); },
+			[](void* dst, const void* src) { ::new (dst) Fn(*static_cast<const Fn*>(src)); },
+			[](void* dst, void* src) noexcept { ::new (dst) Fn(std::move(*static_cast<Fn*>(src))); },
+			[](void* self) noexcept { static_cast<Fn*>(self)->~Fn(); },
+		};
+
+		void reset() noexcept
+		{
+			if (ops_) {
+				ops_->destroy(storage_);
+				ops_ = nullptr;
+			}
+		}
+
+		alignas(std::max_align_t) mutable std::byte storage_[Capacity];
+		const Ops* ops_ = nullptr;
+	};
+
+	template <typename Sig>
+	class FunctionRef;
+
+	template <typename R, typename... Args>
+	class FunctionRef<R(Args...)> {
+	public:
+		template <typename F>
+			requires(not std::is_same_v<std::decay_t<F>, FunctionRef> and std::is_invocable_r_v<R, F&, Args...>)
+		FunctionRef(F&& f) noexcept
+		{
+			if constexpr (std::is_function_v<std::remove_reference_t<F>>) {
+				target_.fn = reinterpret_cast<void (*)()>(&f);
+				call_ = [](Target t, Args&&... args) -> R {
+					return std::invoke(reinterpret_cast<std::remove_reference_t<F>*>(t.fn), std::forward<Args>(args)...);
+				};
+			}
+			else {
+				target_.obj = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+				call_ = [](Target t, Args&&... args) -> R {
+					return std::invoke(*static_cast<std::remove_reference_t<F>*>(t.obj), std::forward<Args>(args)...);
+				};
+			}
+		}
+
+		R operator()(Args... args) const { return call_(target_, std::forward<Args>(args)...); }
+
+	private:
+		union Target {
+			void* obj;
+			void (*fn)();
+		};
+
+		Target target_{};
+		R (*call_)(Target, Args&&...) = nullptr;
+	};
+
+} // namespace Volt
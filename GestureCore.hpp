@@ -0,0 +1,304 @@
+#pragma once
+// GestureCore.hpp -- pointer tracking and gesture recognition, zero SDL/framework dependency.
+//
+// Samples are expected in window pixels with timestamps in nanoseconds taken
+// from the input events themselves, so velocities don't depend on how fast
+// the app gets around to processing them.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Gesture {
+
+	enum class Phase : uint8_t { Down, Move, Up, Cancel };
+
+	struct Sample {
+		uint64_t pointer_id = 0;
+		float x = 0.f, y = 0.f;
+		uint64_t t_ns = 0;
+		Phase phase = Phase::Move;
+	};
+
+	enum class Type : uint8_t {
+		Tap,
+		LongPress,
+		DragStart,
+		Drag,
+		DragEnd,
+		Fling,      // follows DragEnd when the release velocity is high enough
+		PinchStart,
+		Pinch,
+		PinchEnd,
+	};
+
+	struct Event {
+		Type type = Type::Tap;
+		uint64_t pointer_id = 0;
+		float x = 0.f, y = 0.f;     // pointer position, pinch centre for pinches
+		float dx = 0.f, dy = 0.f;   // movement since the previous Drag
+		float vx = 0.f, vy = 0.f;   // px/s, set on DragEnd and Fling
+		float scale = 1.f;          // pinch distance relative to PinchStart
+		uint64_t t_ns = 0;
+	};
+
+	struct Config {
+		float tap_slop_px = 10.f;                 // movement allowed before a press becomes a drag
+		uint64_t tap_max_ns = 300000000;          // 300ms
+		uint64_t long_press_ns = 500000000;       // 500ms
+		float fling_min_px_s = 300.f;
+		uint64_t velocity_window_ns = 100000000;  // samples used for the release velocity
+	};
+
+	class Recognizer {
+	public:
+		void setConfig(const Config& config) { cfg_ = config; }
+		const Config& config() const { return cfg_; }
+
+		// Feeds one sample and appends whatever it completes to out.
+		void feed(const Sample& s, std::vector<Event>& out)
+		{
+			if (s.phase == Phase::Down) {
+				purgeReleased();
+				Pointer p;
+				p.id = s.pointer_id;
+				p.down_x = p.x = s.x;
+				p.down_y = p.y = s.y;
+				p.down_t = p.last_t = s.t_ns;
+				p.history.push({ s.x, s.y, s.t_ns });
+				pointers_.push_back(p);
+				if (activeCount() == 2 && !pinching_) startPinch(s.t_ns, out);
+				return;
+			}
+
+			Pointer* p = find(s.pointer_id);
+			if (p == nullptr || p->released) return;
+			const float dx = s.x - p->x, dy = s.y - p->y;
+			p->x = s.x, p->y = s.y, p->last_t = s.t_ns;
+			p->history.push({ s.x, s.y, s.t_ns });
+			while (p->history.size() > 2 && s.t_ns - p->history.front().t > cfg_.velocity_window_ns)
+				p->history.popFront();
+
+			if (s.phase == Phase::Move) {
+				if (pinching_) {
+					emitPinch(Type::Pinch, s.t_ns, out);
+					return;
+				}
+				if (!p->dragging && !p->consumed && std::hypot(s.x - p->down_x, s.y - p->down_y) > cfg_.tap_slop_px) {
+					p->dragging = true;
+					out.push_back(make(Type::DragStart, *p, p->down_x, p->down_y, s.t_ns));
+				}
+				if (p->dragging) {
+					Event e = make(Type::Drag, *p, s.x, s.y, s.t_ns);
+					e.dx = dx, e.dy = dy;
+					out.push_back(e);
+				}
+				return;
+			}
+
+			// Up / Cancel
+			const auto v = velocityOf(*p);
+			p->released = true;
+			p->vx = v.first, p->vy = v.second;
+			if (pinching_) {
+				emitPinch(Type::PinchEnd, s.t_ns, out);
+				pinching_ = false;
+				for (auto& other : pointers_) other.consumed = true;
+				return;
+			}
+			if (p->dragging) {
+				Event e = make(Type::DragEnd, *p, s.x, s.y, s.t_ns);
+				e.vx = v.first, e.vy = v.second;
+				out.push_back(e);
+				if (s.phase == Phase::Up && std::hypot(v.first, v.second) >= cfg_.fling_min_px_s) {
+					e.type = Type::Fling;
+					out.push_back(e);
+				}
+				return;
+			}
+			if (s.phase == Phase::Up && !p->long_pressed && !p->consumed && s.t_ns - p->down_t <= cfg_.tap_max_ns)
+				out.push_back(make(Type::Tap, *p, s.x, s.y, s.t_ns));
+		}
+
+		// Time based gestures (long press). Call at least once per frame.
+		void tick(uint64_t now_ns, std::vector<Event>& out)
+		{
+			for (auto& p : pointers_) {
+				if (p.released || p.dragging || p.long_pressed || p.consumed || pinching_) continue;
+				if (now_ns >= p.down_t && now_ns - p.down_t >= cfg_.long_press_ns) {
+					p.long_pressed = true;
+					out.push_back(make(Type::LongPress, p, p.x, p.y, now_ns));
+				}
+			}
+		}
+
+		// earliest time tick() can produce a gesture, UINT64_MAX when none is pending
+		uint64_t nextDeadline() const
+		{
+			uint64_t next = UINT64_MAX;
+			for (const auto& p : pointers_) {
+				if (p.released || p.dragging || p.long_pressed || p.consumed || pinching_) continue;
+				next = std::min(next, p.down_t + cfg_.long_press_ns);
+			}
+			return next;
+		}
+
+		// px/s over the velocity window; for a released pointer the velocity at
+		// release, available until the next Down
+		std::optional<std::pair<float, float>> velocity(uint64_t pointer_id) const
+		{
+			for (const auto& p : pointers_) {
+				if (p.id != pointer_id) continue;
+				if (p.released) return std::make_pair(p.vx, p.vy);
+				return velocityOf(p);
+			}
+			return std::nullopt;
+		}
+
+		std::size_t activeCount() const
+		{
+			return static_cast<std::size_t>(std::count_if(pointers_.begin(), pointers_.end(),
+				[](const Pointer& p) { return !p.released; }));
+		}
+
+		void reset()
+		{
+			pointers_.clear();
+			pinching_ = false;
+		}
+
+	private:
+		struct Point {
+			float x, y;
+			uint64_t t;
+		};
+
+		// Fixed ring of the latest samples so a drag never allocates. When full
+		// the oldest sample goes, at 1 kHz input that still covers 128ms.
+		struct History {
+			static constexpr std::size_t Capacity = 128;
+
+			void push(const Point& pt)
+			{
+				points_[(head_ + count_) % Capacity] = pt;
+				if (count_ < Capacity) ++count_;
+				else head_ = (head_ + 1) % Capacity;
+			}
+
+			void popFront() { head_ = (head_ + 1) % Capacity, --count_; }
+			std::size_t size() const { return count_; }
+			const Point& front() const { return points_[head_]; }
+			const Point& back() const { return points_[(head_ + count_ - 1) % Capacity]; }
+
+		private:
+			std::array<Point, Capacity> points_{};
+			std::size_t head_ = 0, count_ = 0;
+		};
+
+		struct Pointer {
+			uint64_t id = 0;
+			float down_x = 0.f, down_y = 0.f, x = 0.f, y = 0.f;
+			uint64_t down_t = 0, last_t = 0;
+			bool dragging = false, long_pressed = false, released = false;
+			bool consumed = false; // took part in a pinch, no tap/drag/long press anymore
+			float vx = 0.f, vy = 0.f;
+			History history;
+		};
+
+		Pointer* find(uint64_t id)
+		{
+			for (auto& p : pointers_)
+				if (p.id == id && !p.released) return &p;
+			return nullptr;
+		}
+
+		void purgeReleased()
+		{
+			pointers_.erase(std::remove_if(pointers_.begin(), pointers_.end(),
+				[](const Pointer& p) { return p.released; }), pointers_.end());
+		}
+
+		std::pair<float, float> velocityOf(const Pointer& p) const
+		{
+			if (p.history.size() < 2) return { 0.f, 0.f };
+			const Point& a = p.history.front();
+			const Point& b = p.history.back();
+			if (b.t <= a.t) return { 0.f, 0.f };
+			const float secs = static_cast<float>(b.t - a.t) / 1e9f;
+			return { (b.x - a.x) / secs, (b.y - a.y) / secs };
+		}
+
+		static Event make(Type type, const Pointer& p, float x, float y, uint64_t t)
+		{
+			Event e;
+			e.type = type;
+			e.pointer_id = p.id;
+			e.x = x, e.y = y;
+			e.t_ns = t;
+			return e;
+		}
+
+		// the first two active pointers make the pinch
+		bool pinchPair(const Pointer*& a, const Pointer*& b) const
+		{
+			a = b = nullptr;
+			for (const auto& p : pointers_) {
+				if (p.released) continue;
+				if (a == nullptr) a = &p;
+				else { b = &p; return true; }
+			}
+			return false;
+		}
+
+		void startPinch(uint64_t t, std::vector<Event>& out)
+		{
+			const Pointer *a, *b;
+			if (!pinchPair(a, b)) return;
+			for (auto& p : pointers_) {
+				if (p.released) continue;
+				if (p.dragging) {
+					p.dragging = false;
+					out.push_back(make(Type::DragEnd, p, p.x, p.y, t));
+				}
+				p.consumed = true;
+			}
+			pinch_start_dist_ = std::max(1.f, std::hypot(b->x - a->x, b->y - a->y));
+			pinching_ = true;
+			emitPinch(Type::PinchStart, t, out);
+		}
+
+		void emitPinch(Type type, uint64_t t, std::vector<Event>& out)
+		{
+			const Pointer *a, *b;
+			if (!pinchPair(a, b)) {
+				// one of the pair was just released, report the last known pair state
+				Event e;
+				e.type = type;
+				e.scale = last_pinch_scale_;
+				e.x = last_pinch_x_, e.y = last_pinch_y_;
+				e.t_ns = t;
+				out.push_back(e);
+				return;
+			}
+			Event e;
+			e.type = type;
+			e.pointer_id = a->id;
+			e.x = (a->x + b->x) / 2.f, e.y = (a->y + b->y) / 2.f;
+			e.scale = std::hypot(b->x - a->x, b->y - a->y) / pinch_start_dist_;
+			e.t_ns = t;
+			last_pinch_scale_ = e.scale, last_pinch_x_ = e.x, last_pinch_y_ = e.y;
+			out.push_back(e);
+		}
+
+		Config cfg_{};
+		std::vector<Pointer> pointers_;
+		bool pinching_ = false;
+		float pinch_start_dist_ = 1.f;
+		float last_pinch_scale_ = 1.f, last_pinch_x_ = 0.f, last_pinch_y_ = 0.f;
+	};
+
+} // namespace Gesture
@@ -0,0 +1,536 @@
+#pragma once
+// LayoutCore.hpp -- flexbox-like layout with cached measurements, zero SDL/framework dependency.
+//
+// Nodes form a tree of rows and columns. compute() sizes children from their
+// content first (measure pass) and then places them (arrange pass). Each
+// node remembers the constraint it was last laid out under and the result;
+// asked again under the same constraint, a clean node answers from cache
+// without visiting its subtree. markDirty() flags a node and its ancestors,
+// so changing one label's text re-lays out the chain up to the root while
+// the siblings along it come from cache, and only frames that actually moved
+// are reported through changed().
+//
+// Supported: row/column direction, justify, align-items/align-self (with
+// stretch), grow/shrink/basis, width/height in px or percent, min/max,
+// padding, margin, gap and absolute children placed by insets. One line per
+// container, no wrapping; min/max are applied once after flexing instead of
+// re-distributing the remaining space.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Layout {
+
+	using NodeId = uint32_t;
+	inline constexpr NodeId InvalidNode = UINT32_MAX;
+
+	enum class Direction : uint8_t { Row, Column };
+	enum class Justify : uint8_t { Start, Center, End, SpaceBetween, SpaceAround, SpaceEvenly };
+	enum class Align : uint8_t { Auto, Start, Center, End, Stretch }; // Auto: use the parent's align_items
+	enum class Position : uint8_t { Relative, Absolute };
+
+	struct Value {
+		enum class Unit : uint8_t { Auto, Px, Percent };
+		Unit unit = Unit::Auto;
+		float v = 0.f;
+
+		static Value px(float v) { return { Unit::Px, v }; }
+		static Value pct(float v) { return { Unit::Percent, v }; }
+
+		bool isAuto() const { return unit == Unit::Auto; }
+
+		// NaN for auto, or a percentage of an unknown base
+		float resolve(float base) const
+		{
+			if (unit == Unit::Px) return v;
+			if (unit == Unit::Percent and not std::isnan(base)) return v * base / 100.f;
+			return std::numeric_limits<float>::quiet_NaN();
+		}
+	};
+
+	struct Edges {
+		float left = 0.f, top = 0.f, right = 0.f, bottom = 0.f;
+	};
+
+	struct Insets {
+		Value left, top, right, bottom;
+	};
+
+	struct Size {
+		float w = 0.f, h = 0.f;
+	};
+
+	struct Rect {
+		float x = 0.f, y = 0.f, w = 0.f, h = 0.f;
+		bool operator==(const Rect&) const = default;
+	};
+
+	struct Style {
+		Direction direction = Direction::Column;
+		Justify justify = Justify::Start;
+		Align align_items = Align::Stretch;
+		Align align_self = Align::Auto;
+		Position position = Position::Relative;
+		float grow = 0.f, shrink = 1.f;
+		Value basis;
+		Value width, height;
+		Value min_width, min_height, max_width, max_height;
+		Edges padding, margin;
+		float gap = 0.f;
+		Insets inset; // Position::Absolute only, relative to the parent's border box
+	};
+
+	// content size of a leaf for the space available to it, NaN when unbounded
+	using MeasureFn = std::function<Size(float avail_w, float avail_h)>;
+
+	class Tree {
+	public:
+		struct Stats {
+			uint32_t layouts = 0;       // nodes laid out, cache hits excluded
+			uint32_t cache_hits = 0;
+			uint32_t measure_calls = 0; // MeasureFn invocations
+		};
+
+		NodeId create(const Style& style = {})
+		{
+			NodeId id;
+			if (not free_.empty()) {
+				id = free_.back();
+				free_.pop_back();
+				nodes_[id] = Node{};
+			}
+			else {
+				id = static_cast<NodeId>(nodes_.size());
+				nodes_.emplace_back();
+			}
+			nodes_[id].style = style;
+			nodes_[id].alive = true;
+			return id;
+		}
+
+		// detaches the node and frees it together with its subtree
+		void destroy(NodeId id)
+		{
+			if (not alive(id)) return;
+			if (nodes_[id].parent != InvalidNode)
+				removeChild(nodes_[id].parent, id);
+			std::vector<NodeId> stack{ id };
+			while (not stack.empty()) {
+				const NodeId cur = stack.back();
+				stack.pop_back();
+				for (NodeId ch : nodes_[cur].children) stack.push_back(ch);
+				nodes_[cur] = Node{};
+				free_.push_back(cur);
+			}
+		}
+
+		// room for n nodes in total, for trees built in one go
+		void reserve(std::size_t n) { nodes_.reserve(n); }
+
+		bool alive(NodeId id) const { return id < nodes_.size() and nodes_[id].alive; }
+
+		void appendChild(NodeId parent, NodeId child)
+		{
+			insertChild(parent, child, nodes_[parent].children.size());
+		}
+
+		void insertChild(NodeId parent, NodeId child, std::size_t index)
+		{
+			if (nodes_[child].parent != InvalidNode)
+				removeChild(nodes_[child].parent, child);
+			auto& kids = nodes_[parent].children;
+			kids.insert(kids.begin() + static_cast<std::ptrdiff_t>(std::min(index, kids.size())), child);
+			nodes_[child].parent = parent;
+			nodes_[child].has_abs = false;
+			markDirty(parent);
+		}
+
+		void removeChild(NodeId parent, NodeId child)
+		{
+			auto& kids = nodes_[parent].children;
+			auto it = std::find(kids.begin(), kids.end(), child);
+			if (it == kids.end()) return;
+			kids.erase(it);
+			nodes_[child].parent = InvalidNode;
+			markDirty(parent);
+		}
+
+		const std::vector<NodeId>& children(NodeId id) const { return nodes_[id].children; }
+		NodeId parent(NodeId id) const { return nodes_[id].parent; }
+
+		const Style& style(NodeId id) const { return nodes_[id].style; }
+
+		void setStyle(NodeId id, const Style& style)
+		{
+			nodes_[id].style = style;
+			markDirty(id);
+		}
+
+		// edit(Style&) in place, then marks the node dirty
+		template <typename F>
+		void updateStyle(NodeId id, F&& edit)
+		{
+			edit(nodes_[id].style);
+			markDirty(id);
+		}
+
+		void setMeasure(NodeId id, MeasureFn measure)
+		{
+			nodes_[id].measure = std::move(measure);
+			markDirty(id);
+		}
+
+		// Call when whatever the node's MeasureFn reads changed (its text, its
+		// font). Drops the node's measurement and the cached layouts up to the root.
+		void markDirty(NodeId id)
+		{
+			for (auto& m : nodes_[id].measured) m.valid = false;
+			while (id != InvalidNode) {
+				Node& n = nodes_[id];
+				if (n.dirty) break; // ancestors of a dirty node are dirty already
+				n.dirty = true;
+				for (auto& e : n.measure_cache) e.valid = false;
+				n.layout_cache.valid = false;
+				id = n.parent;
+			}
+		}
+
+		bool isDirty(NodeId id) const { return nodes_[id].dirty; }
+
+		// Lays out the tree under root for a w x h area. Cheap when nothing is
+		// dirty and the area didn't change.
+		void compute(NodeId root, float w, float h)
+		{
+			stats_ = {};
+			changed_.clear();
+			Constraint c;
+			c.aw = w, c.ah = h;
+			c.ew = not std::isnan(w), c.eh = not std::isnan(h);
+			c.pw = w, c.ph = h;
+			const Size sz = layoutNode(root, c, true);
+			setFrame(root, { 0.f, 0.f, sz.w, sz.h });
+			resolveAbsolute(root, 0.f, 0.f);
+		}
+
+		// relative to the parent's border box
+		const Rect& frame(NodeId id) const { return nodes_[id].frame; }
+		// relative to the root passed to compute()
+		const Rect& absoluteFrame(NodeId id) const { return nodes_[id].abs; }
+
+		// nodes whose absolute frame changed in the last compute(), parents first
+		const std::vector<NodeId>& changed() const { return changed_; }
+
+		const Stats& lastStats() const { return stats_; }
+
+	private:
+		static bool same(float a, float b) { return a == b or (std::isnan(a) and std::isnan(b)); }
+
+		struct Constraint {
+			float aw = 0.f, ah = 0.f; // available size, NaN = unbounded
+			bool ew = false, eh = false; // the node must take exactly aw / ah
+			float pw = 0.f, ph = 0.f; // base for percentages
+
+			bool operator==(const Constraint& o) const
+			{
+				return same(aw, o.aw) and same(ah, o.ah) and ew == o.ew and eh == o.eh and same(pw, o.pw) and same(ph, o.ph);
+			}
+		};
+
+		struct CacheEntry {
+			Constraint c;
+			Size size;
+			bool valid = false;
+		};
+
+		struct Measured {
+			float aw = 0.f, ah = 0.f;
+			Size size;
+			bool valid = false;
+		};
+
+		// a node is typically measured under a few different constraints per
+		// pass (free, stretched, with its final main size), keep them all
+		static constexpr std::size_t CacheSlots = 4;
+
+		struct Node {
+			Style style;
+			MeasureFn measure;
+			NodeId parent = InvalidNode;
+			std::vector<NodeId> children;
+			Rect frame, abs;
+			std::array<CacheEntry, CacheSlots> measure_cache{};
+			CacheEntry layout_cache;
+			std::array<Measured, CacheSlots> measured{};
+			uint8_t next_measure_slot = 0, next_measured_slot = 0;
+			bool alive = false;
+			bool dirty = true;
+			bool has_abs = false;
+			bool touched = false; // laid out (not from cache) in the current arrange pass
+		};
+
+		struct Item {
+			NodeId id;
+			float basis, main, cross;
+			float m_main, m_cross; // margins, both sides together
+			Align align;
+			bool cross_auto;
+		};
+
+		static float axis(const Edges& e, int a, bool end) { return a == 0 ? (end ? e.right : e.left) : (end ? e.bottom : e.top); }
+
+		static float clampAxis(const Style& s, int a, float v, float base)
+		{
+			if (std::isnan(v)) return v;
+			const float lo = (a == 0 ? s.min_width : s.min_height).resolve(base);
+			const float hi = (a == 0 ? s.max_width : s.max_height).resolve(base);
+			if (not std::isnan(hi)) v = std::min(v, hi);
+			if (not std::isnan(lo)) v = std::max(v, lo);
+			return std::max(v, 0.f);
+		}
+
+		Size measureLeaf(Node& n, float aw, float ah)
+		{
+			if (not n.measure) return {};
+			for (const auto& m : n.measured)
+				if (m.valid and same(m.aw, aw) and same(m.ah, ah))
+					return m.size;
+			++stats_.measure_calls;
+			Measured& slot = n.measured[n.next_measured_slot];
+			n.next_measured_slot = static_cast<uint8_t>((n.next_measured_slot + 1) % CacheSlots);
+			slot = { aw, ah, n.measure(aw, ah), true };
+			return slot.size;
+		}
+
+		Size layoutNode(NodeId id, const Constraint& c, bool perform)
+		{
+			Node& n = nodes_[id];
+			if (n.layout_cache.valid and n.layout_cache.c == c) {
+				++stats_.cache_hits;
+				return n.layout_cache.size;
+			}
+			if (not perform) {
+				for (const auto& e : n.measure_cache) {
+					if (e.valid and e.c == c) {
+						++stats_.cache_hits;
+						return e.size;
+					}
+				}
+			}
+			++stats_.layouts;
+			const Style& s = n.style;
+			const float avail[2] = { c.aw, c.ah };
+			const float base[2] = { c.pw, c.ph };
+			const bool exact[2] = { c.ew, c.eh };
+			const float pad[2] = { s.padding.left + s.padding.right, s.padding.top + s.padding.bottom };
+			float own[2];
+			for (int a = 0; a < 2; ++a)
+				own[a] = exact[a] ? avail[a] : clampAxis(s, a, (a == 0 ? s.width : s.height).resolve(base[a]), base[a]);
+
+			float inner[2];
+			for (int a = 0; a < 2; ++a) {
+				const float outer = not std::isnan(own[a]) ? own[a] : avail[a];
+				inner[a] = std::isnan(outer) ? outer : std::max(0.f, outer - pad[a]);
+			}
+
+			if (n.children.empty()) {
+				if (std::isnan(own[0]) or std::isnan(own[1])) {
+					const Size content = measureLeaf(n, inner[0], inner[1]);
+					if (std::isnan(own[0])) own[0] = clampAxis(s, 0, content.w + pad[0], base[0]);
+					if (std::isnan(own[1])) own[1] = clampAxis(s, 1, content.h + pad[1], base[1]);
+				}
+				return finish(n, c, { own[0], own[1] }, perform);
+			}
+
+			const int main = s.direction == Direction::Row ? 0 : 1;
+			const int cross = 1 - main;
+			const bool main_definite = not std::isnan(own[main]);
+			const bool cross_definite = not std::isnan(own[cross]);
+
+			// flex basis and hypothetical cross size of every in-flow child
+			std::vector<Item> items;
+			items.reserve(n.children.size());
+			for (NodeId ch : n.children) {
+				const Style& cs = nodes_[ch].style;
+				if (cs.position == Position::Absolute) continue;
+				Item it{};
+				it.id = ch;
+				it.m_main = axis(cs.margin, main, false) + axis(cs.margin, main, true);
+				it.m_cross = axis(cs.margin, cross, false) + axis(cs.margin, cross, true);
+				it.align = cs.align_self == Align::Auto ? s.align_items : cs.align_self;
+				it.cross_auto = (cross == 0 ? cs.width : cs.height).isAuto();
+				it.basis = cs.basis.resolve(inner[main]);
+				if (std::isnan(it.basis))
+					it.basis = (main == 0 ? cs.width : cs.height).resolve(inner[main]);
+				if (std::isnan(it.basis)) {
+					Constraint cc = childConstraint(inner, main, std::isnan(inner[main]) ? inner[main] : inner[main] - it.m_main, false, cross,
+						stretchCross(it, cross_definite, inner[cross]), it);
+					const Size sz = layoutNode(ch, cc, false);
+					it.basis = main == 0 ? sz.w : sz.h;
+				}
+				it.basis = clampAxis(cs, main, it.basis, inner[main]);
+				items.push_back(it);
+			}
+
+			// resolve flexible lengths
+			const float gaps = items.empty() ? 0.f : s.gap * static_cast<float>(items.size() - 1);
+			float used = gaps;
+			for (const auto& it : items) used += it.basis + it.m_main;
+			const float container_main = main_definite ? inner[main] : used;
+			const float free_space = container_main - used;
+			float grow = 0.f, shrink = 0.f;
+			for (const auto& it : items) {
+				grow += nodes_[it.id].style.grow;
+				shrink += nodes_[it.id].style.shrink * it.basis;
+			}
+			for (auto& it : items) {
+				const Style& cs = nodes_[it.id].style;
+				it.main = it.basis;
+				if (free_space > 0.f and grow > 0.f)
+					it.main += free_space * cs.grow / grow;
+				else if (free_space < 0.f and shrink > 0.f)
+					it.main += free_space * cs.shrink * it.basis / shrink;
+				it.main = clampAxis(cs, main, it.main, inner[main]);
+			}
+
+			// cross sizes with the main size fixed
+			float container_cross = cross_definite ? inner[cross] : 0.f;
+			for (auto& it : items) {
+				Constraint cc = childConstraint(inner, main, it.main, true, cross, stretchCross(it, cross_definite, inner[cross]), it);
+				const Size sz = layoutNode(it.id, cc, false);
+				it.cross = cross == 0 ? sz.w : sz.h;
+				if (not cross_definite)
+					container_cross = std::max(container_cross, it.cross + it.m_cross);
+			}
+			if (not cross_definite and not std::isnan(avail[cross]) and not exact[cross])
+				container_cross = std::min(container_cross, inner[cross]);
+
+			if (std::isnan(own[main])) own[main] = clampAxis(s, main, container_main + pad[main], base[main]);
+			if (std::isnan(own[cross])) own[cross] = clampAxis(s, cross, container_cross + pad[cross], base[cross]);
+
+			if (perform) {
+				const float final_inner[2] = { std::max(0.f, own[0] - pad[0]), std::max(0.f, own[1] - pad[1]) };
+				float remaining = final_inner[main] - gaps;
+				for (const auto& it : items) remaining -= it.main + it.m_main;
+				float lead = 0.f, between = 0.f;
+				const float count = static_cast<float>(items.size());
+				switch (s.justify) {
+				case Justify::Start: break;
+				case Justify::Center: lead = remaining / 2.f; break;
+				case Justify::End: lead = remaining; break;
+				case Justify::SpaceBetween: between = count > 1.f ? std::max(0.f, remaining) / (count - 1.f) : 0.f; break;
+				case Justify::SpaceAround: between = count > 0.f ? std::max(0.f, remaining) / count : 0.f, lead = between / 2.f; break;
+				case Justify::SpaceEvenly: between = std::max(0.f, remaining) / (count + 1.f), lead = between; break;
+				}
+				float pos = axis(s.padding, main, false) + lead;
+				for (auto& it : items) {
+					const Style& cs = nodes_[it.id].style;
+					float cross_size = it.cross;
+					if (it.align == Align::Stretch and it.cross_auto)
+						cross_size = clampAxis(cs, cross, final_inner[cross] - it.m_cross, final_inner[cross]);
+					Constraint cc;
+					(main == 0 ? cc.aw : cc.ah) = it.main;
+					(cross == 0 ? cc.aw : cc.ah) = cross_size;
+					cc.ew = cc.eh = true;
+					cc.pw = final_inner[0], cc.ph = final_inner[1];
+					const Size sz = layoutNode(it.id, cc, true);
+					const float room = final_inner[cross] - (cross == 0 ? sz.w : sz.h) - it.m_cross;
+					float cross_pos = axis(s.padding, cross, false) + axis(cs.margin, cross, false);
+					if (it.align == Align::Center) cross_pos += room / 2.f;
+					else if (it.align == Align::End) cross_pos += room;
+					const float main_pos = pos + axis(cs.margin, main, false);
+					setFrame(it.id, main == 0 ? Rect{ main_pos, cross_pos, sz.w, sz.h } : Rect{ cross_pos, main_pos, sz.w, sz.h });
+					pos += it.main + it.m_main + s.gap + between;
+				}
+				for (NodeId ch : n.children)
+					if (nodes_[ch].style.position == Position::Absolute)
+						placeAbsolute(ch, own[0], own[1]);
+			}
+			return finish(n, c, { own[0], own[1] }, perform);
+		}
+
+		static bool stretchCross(const Item& it, bool cross_definite, float inner_cross)
+		{
+			return it.align == Align::Stretch and it.cross_auto and cross_definite and not std::isnan(inner_cross);
+		}
+
+		static Constraint childConstraint(const float inner[2], int main, float main_avail, bool main_exact, int cross, bool cross_exact, const Item& it)
+		{
+			Constraint cc;
+			const float cross_avail = std::isnan(inner[cross]) ? inner[cross] : std::max(0.f, inner[cross] - it.m_cross);
+			(main == 0 ? cc.aw : cc.ah) = main_avail;
+			(main == 0 ? cc.ew : cc.eh) = main_exact;
+			(cross == 0 ? cc.aw : cc.ah) = cross_avail;
+			(cross == 0 ? cc.ew : cc.eh) = cross_exact;
+			cc.pw = inner[0], cc.ph = inner[1];
+			return cc;
+		}
+
+		void placeAbsolute(NodeId id, float parent_w, float parent_h)
+		{
+			const Style& cs = nodes_[id].style;
+			const float l = cs.inset.left.resolve(parent_w), r = cs.inset.right.resolve(parent_w);
+			const float t = cs.inset.top.resolve(parent_h), b = cs.inset.bottom.resolve(parent_h);
+			const float mw = cs.margin.left + cs.margin.right, mh = cs.margin.top + cs.margin.bottom;
+			Constraint cc;
+			cc.aw = parent_w - mw, cc.ah = parent_h - mh;
+			cc.pw = parent_w, cc.ph = parent_h;
+			if (cs.width.isAuto() and not std::isnan(l) and not std::isnan(r))
+				cc.aw = std::max(0.f, parent_w - l - r - mw), cc.ew = true;
+			if (cs.height.isAuto() and not std::isnan(t) and not std::isnan(b))
+				cc.ah = std::max(0.f, parent_h - t - b - mh), cc.eh = true;
+			const Size sz = layoutNode(id, cc, true);
+			const float x = not std::isnan(l) ? l + cs.margin.left : not std::isnan(r) ? parent_w - r - sz.w - cs.margin.right : cs.margin.left;
+			const float y = not std::isnan(t) ? t + cs.margin.top : not std::isnan(b) ? parent_h - b - sz.h - cs.margin.bottom : cs.margin.top;
+			setFrame(id, { x, y, sz.w, sz.h });
+		}
+
+		Size finish(Node& n, const Constraint& c, Size size, bool perform)
+		{
+			if (not perform) {
+				n.measure_cache[n.next_measure_slot] = { c, size, true };
+				n.next_measure_slot = static_cast<uint8_t>((n.next_measure_slot + 1) % CacheSlots);
+			}
+			else
+				n.layout_cache = { c, size, true };
+			if (perform) {
+				n.dirty = false;
+				n.touched = true;
+			}
+			return size;
+		}
+
+		void setFrame(NodeId id, const Rect& r)
+		{
+			nodes_[id].frame = r;
+		}
+
+		// walks only into subtrees that were laid out or whose origin moved
+		void resolveAbsolute(NodeId id, float ox, float oy)
+		{
+			Node& n = nodes_[id];
+			const Rect abs{ ox + n.frame.x, oy + n.frame.y, n.frame.w, n.frame.h };
+			const bool moved = not n.has_abs or abs.x != n.abs.x or abs.y != n.abs.y;
+			if (moved or abs.w != n.abs.w or abs.h != n.abs.h)
+				changed_.push_back(id);
+			n.abs = abs;
+			n.has_abs = true;
+			const bool descend = moved or n.touched;
+			n.touched = false;
+			if (descend)
+				for (NodeId ch : n.children)
+					resolveAbsolute(ch, abs.x, abs.y);
+		}
+
+		std::vector<Node> nodes_;
+		std::vector<NodeId> free_;
+		std::vector<NodeId> changed_;
+		Stats stats_;
+	};
+
+} // namespace Layout
@@ -188,6 +188,65 @@ private:
 
 
 
+// Unbounded multi-producer/single-consumer queue (Vyukov's intrusive design).
+// enqueue is wait-free for producers; dequeue must only be called from one thread.
+// dequeue can briefly report empty while a producer is in the middle of an enqueue.
+template <typename T>
+class MPSCQueue {
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+public:
+    MPSCQueue() {
+        Node* stub = new Node();
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    ~MPSCQueue() {
+        T value;
+        while (dequeue(value)) {}
+        delete tail_;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Enqueue: safe from any number of threads
+    void enqueue(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Dequeue: consumer thread only. Returns true on success (value filled)
+    bool dequeue(T& value) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;  // Queue is empty (or a push is not published yet)
+        }
+        value = std::move(next->value);
+        tail_ = next;  // next becomes the new stub
+        delete tail;
+        return true;
+    }
+
+    // Check if empty (consumer side)
+    bool empty() const {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    alignas(64) std::atomic<Node*> head_;  // Producers push here
+    alignas(64) Node* tail_;               // Consumer-owned stub
+};
+
+
+
 
 
 
@@ -0,0 +1,338 @@
+#pragma once
+// Profiler.hpp -- scoped frame profiler with Chrome trace export, zero SDL dependency.
+//
+// Everything below is only compiled when VOLT_PROFILE is defined, otherwise the
+// VOLT_PROFILE_* macros expand to nothing and no code or storage is left behind.
+//
+//	VOLT_PROFILE_SCOPE("layout");          // times the enclosing scope
+//	VOLT_PROFILE_VIEW(view);               // same, named "type:id" of an IView
+//	VOLT_PROFILE_THREAD("decoder");        // names the calling thread in the trace
+//	Profiler::Get().exportChromeTrace("trace.json"); // open in chrome://tracing or Perfetto
+//
+// Every thread records into its own lock-free SPSC ring; the UI thread drains
+// all rings once per frame in endFrame(), so recording never takes a lock.
+
+#ifdef VOLT_PROFILE
+
+#include "PCQueue.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfileEvent
+{
+	std::array<char, 48> name{}; // truncated copy, so view names can die before export
+	uint64_t begin_ns = 0;
+	uint64_t end_ns = 0;
+	uint16_t depth = 0;
+};
+
+class Profiler
+{
+public:
+	static constexpr size_t ThreadBufferCapacity = 1 << 12; // events per thread between two frames
+	static constexpr size_t FrameHistory = 240;
+
+	struct ThreadBuffer
+	{
+		SPSCQueue<ProfileEvent, ThreadBufferCapacity> events;
+		uint32_t tid = 0;
+		uint16_t depth = 0;
+		std::string name;
+	};
+
+	struct Record
+	{
+		ProfileEvent event;
+		uint32_t tid = 0;
+	};
+
+	Profiler(const Profiler &) = delete;
+	Profiler(Profiler &&) = delete;
+
+	static Profiler &Get()
+	{
+		static Profiler instance;
+		return instance;
+	}
+
+	static uint64_t Now()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	// buffer of the calling thread, registered on first use and kept alive
+	// for the lifetime of the profiler so late drains stay valid
+	ThreadBuffer &threadBuffer()
+	{
+		thread_local ThreadBuffer *tb = nullptr;
+		if (nullptr == tb)
+		{
+			std::lock_guard<std::mutex> lock(buffers_mtx_);
+			buffers_.push_back(std::make_unique<ThreadBuffer>());
+			tb = buffers_.back().get();
+			tb->tid = static_cast<uint32_t>(buffers_.size());
+			tb->name = "thread " + std::to_string(tb->tid);
+		}
+		return *tb;
+	}
+
+	void setThreadName(const std::string &_name)
+	{
+		auto &tb = threadBuffer();
+		std::lock_guard<std::mutex> lock(buffers_mtx_);
+		tb.name = _name;
+	}
+
+	bool isRecording() const { return recording_.load(std::memory_order_relaxed); }
+
+	Profiler &setRecording(bool _recording)
+	{
+		recording_.store(_recording, std::memory_order_relaxed);
+		return *this;
+	}
+
+	// upper bound of drained events kept for export, oldest are dropped first
+	Profiler &setMaxRecords(size_t _max)
+	{
+		max_records_ = _max;
+		return *this;
+	}
+
+	Profiler &setFrameBudgetMs(float _ms)
+	{
+		frame_budget_ms_ = _ms;
+		return *this;
+	}
+
+	float getFrameBudgetMs() const { return frame_budget_ms_; }
+
+	Profiler &setOverlayVisible(bool _visible)
+	{
+		overlay_visible_ = _visible;
+		return *this;
+	}
+
+	bool isOverlayVisible() const { return overlay_visible_; }
+
+	// events lost because a thread filled its ring before the next drain
+	uint64_t droppedEvents() const { return dropped_.load(std::memory_order_relaxed); }
+
+	void countDropped() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+	// UI thread only. Marks the start of the work for a frame, idle time spent
+	// waiting for events before this call isn't part of the frame.
+	void beginFrame()
+	{
+		frame_begin_ns_ = Now();
+	}
+
+	// UI thread only. Records the frame as a top level "frame" event, pushes
+	// its duration into the frame-time history and drains every thread ring.
+	void endFrame()
+	{
+		if (0 == frame_begin_ns_)
+			return;
+		const uint64_t end_ns = Now();
+		frame_ms_[frame_head_] = static_cast<float>(end_ns - frame_begin_ns_) / 1e6f;
+		frame_head_ = (frame_head_ + 1) % FrameHistory;
+		frame_count_ = std::min(frame_count_ + 1, FrameHistory);
+		if (isRecording())
+		{
+			ProfileEvent ev;
+			std::strncpy(ev.name.data(), "frame", ev.name.size() - 1);
+			ev.begin_ns = frame_begin_ns_;
+			ev.end_ns = end_ns;
+			if (not threadBuffer().events.enqueue(ev))
+				countDropped();
+		}
+		frame_begin_ns_ = 0;
+		drain();
+	}
+
+	// frame durations in ms, oldest first
+	std::vector<float> frameTimes() const
+	{
+		std::vector<float> out;
+		out.reserve(frame_count_);
+		const size_t first = (frame_head_ + FrameHistory - frame_count_) % FrameHistory;
+		for (size_t i = 0; i < frame_count_; ++i)
+			out.push_back(frame_ms_[(first + i) % FrameHistory]);
+		return out;
+	}
+
+	float lastFrameMs() const
+	{
+		return frame_count_ ? frame_ms_[(frame_head_ + FrameHistory - 1) % FrameHistory] : 0.f;
+	}
+
+	void clear()
+	{
+		drain();
+		std::lock_guard<std::mutex> lock(records_mtx_);
+		records_.clear();
+	}
+
+	// Writes everything drained so far in the Chrome trace-event JSON format.
+	bool exportChromeTrace(const std::string &_path)
+	{
+		drain();
+		std::ofstream out(_path, std::ios::out | std::ios::trunc);
+		if (not out.is_open())
+			return false;
+
+		const uint64_t origin = origin_ns_;
+		bool first = true;
+		auto sep = [&]() -> std::ofstream & {
+			if (not first)
+				out << ",\n";
+			first = false;
+			return out;
+		};
+
+		out << std::fixed << std::setprecision(3);
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		{
+			std::lock_guard<std::mutex> lock(buffers_mtx_);
+			for (const auto &tb : buffers_)
+				sep() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tb->tid
+					  << ",\"args\":{\"name\":\"" << escape(tb->name.c_str()) << "\"}}";
+		}
+		{
+			std::lock_guard<std::mutex> lock(records_mtx_);
+			for (const auto &rec : records_)
+			{
+				const auto &ev = rec.event;
+				const double ts = static_cast<double>(ev.begin_ns - std::min(origin, ev.begin_ns)) / 1e3;
+				const double dur = static_cast<double>(ev.end_ns - ev.begin_ns) / 1e3;
+				sep() << "{\"name\":\"" << escape(ev.name.data()) << "\",\"cat\":\"volt\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+					  << rec.tid << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+			}
+		}
+		out << "\n]}\n";
+		return out.good();
+	}
+
+private:
+	Profiler() : origin_ns_(Now()) { frame_ms_.fill(0.f); }
+
+	void drain()
+	{
+		std::lock_guard<std::mutex> lock(buffers_mtx_);
+		std::lock_guard<std::mutex> rlock(records_mtx_);
+		ProfileEvent ev;
+		for (auto &tb : buffers_)
+		{
+			while (tb->events.dequeue(ev))
+				records_.push_back({ev, tb->tid});
+		}
+		while (records_.size() > max_records_)
+			records_.pop_front();
+	}
+
+	static std::string escape(const char *_s)
+	{
+		std::string out;
+		for (; *_s; ++_s)
+		{
+			const char c = *_s;
+			if (c == '"' or c == '\\')
+				out += '\\', out += c;
+			else if (static_cast<unsigned char>(c) < 0x20)
+				out += ' ';
+			else
+				out += c;
+		}
+		return out;
+	}
+
+private:
+	std::mutex buffers_mtx_;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+	std::mutex records_mtx_;
+	std::deque<Record> records_;
+	size_t max_records_ = 1 << 20;
+	std::atomic<bool> recording_{true};
+	std::atomic<uint64_t> dropped_{0};
+	uint64_t origin_ns_ = 0;
+	uint64_t frame_begin_ns_ = 0;
+	std::array<float, FrameHistory> frame_ms_{};
+	size_t frame_head_ = 0;
+	size_t frame_count_ = 0;
+	float frame_budget_ms_ = 1000.f / 60.f;
+	bool overlay_visible_ = false;
+};
+
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char *_name)
+	{
+		if (not Profiler::Get().isRecording())
+			return;
+		std::strncpy(ev_.name.data(), _name, ev_.name.size() - 1);
+		begin();
+	}
+
+	// "type:id", used for views
+	ProfileScope(const std::string &_type, const std::string &_id)
+	{
+		if (not Profiler::Get().isRecording())
+			return;
+		const std::string name = (_type.empty() ? std::string("view") : _type) + ":" + _id;
+		std::strncpy(ev_.name.data(), name.c_str(), ev_.name.size() - 1);
+		begin();
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+	~ProfileScope()
+	{
+		if (nullptr == tb_)
+			return;
+		ev_.end_ns = Profiler::Now();
+		--tb_->depth;
+		if (not tb_->events.enqueue(ev_))
+			Profiler::Get().countDropped();
+	}
+
+private:
+	void begin()
+	{
+		tb_ = &Profiler::Get().threadBuffer();
+		ev_.depth = tb_->depth++;
+		ev_.begin_ns = Profiler::Now();
+	}
+
+	Profiler::ThreadBuffer *tb_ = nullptr;
+	ProfileEvent ev_;
+};
+
+#define VOLT_PROFILE_CONCAT_(a, b) a##b
+#define VOLT_PROFILE_CONCAT(a, b) VOLT_PROFILE_CONCAT_(a, b)
+#define VOLT_PROFILE_SCOPE(name) ProfileScope VOLT_PROFILE_CONCAT(volt_profile_scope_, __LINE__)(name)
+#define VOLT_PROFILE_VIEW(view) ProfileScope VOLT_PROFILE_CONCAT(volt_profile_scope_, __LINE__)((view)->type, (view)->id)
+#define VOLT_PROFILE_THREAD(name) Profiler::Get().setThreadName(name)
+#define VOLT_PROFILE_FRAME_BEGIN() Profiler::Get().beginFrame()
+#define VOLT_PROFILE_FRAME_END() Profiler::Get().endFrame()
+
+#else
+
+#define VOLT_PROFILE_SCOPE(name)
+#define VOLT_PROFILE_VIEW(view)
+#define VOLT_PROFILE_THREAD(name)
+#define VOLT_PROFILE_FRAME_BEGIN()
+#define VOLT_PROFILE_FRAME_END()
+
+#endif // VOLT_PROFILE
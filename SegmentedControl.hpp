@@ -30,6 +30,8 @@ public:
 		adaptiveVsyncHD.setAdaptiveVsync(adaptiveVsync);
 		attr = _attr;
 		bounds = attr.bounds;
+		markGeometryDirty();
+		subscribeEvents(EVC_POINTER);
 		cv = this;
 
 		// Convert the percentage ONCE, here, and never again.
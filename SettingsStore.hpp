@@ -0,0 +1,377 @@
+#pragma once
+// SettingsStore.hpp -- typed key/value settings with write-behind persistence, zero SDL dependency.
+//
+// Values live in memory; set() only marks the store dirty. A writer thread,
+// started by the first change, waits until no change came in for the quiet
+// period and then writes the whole store to "<path>.tmp" and renames it over
+// <path>, so a crash mid-write never leaves a half written file. flush()
+// writes synchronously, the destructor flushes whatever is still pending.
+//
+// File format, one entry per line:  <type> <key>=<value>
+// type is b(ool), i(nt), f(loat) or s(tring); keys and strings escape \n, \r
+// and \\, keys also escape =.
+// The legacy "winpos:x:y" line is read as window.x / window.y.
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+namespace Volt {
+
+	class SettingsStore {
+	public:
+		using Value = std::variant<bool, int64_t, double, std::string>;
+
+		SettingsStore() = default;
+		SettingsStore(const SettingsStore&) = delete;
+		SettingsStore(SettingsStore&&) = delete;
+
+		~SettingsStore()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mtx_);
+				stop_ = true;
+			}
+			cv_.notify_all();
+			if (writer_.joinable())
+				writer_.join();
+			flush();
+		}
+
+		// Replaces the content with the file at path, which is also where
+		// changes are written to. A missing file is an empty store; false
+		// only when the file exists but can't be read.
+		bool load(const std::string& path)
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			path_ = path;
+			values_.clear();
+			std::error_code ec;
+			if (not std::filesystem::exists(path, ec))
+				return true;
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (not in.is_open())
+				return false;
+			std::string line;
+			while (std::getline(in, line))
+				parseLine(line);
+			return true;
+		}
+
+		// where changes go when nothing was loaded
+		SettingsStore& setPath(const std::string& path)
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			path_ = path;
+			return *this;
+		}
+
+		// no change for this long triggers a background write
+		SettingsStore& setQuietPeriodMs(uint32_t ms)
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			quiet_ = std::chrono::milliseconds(ms);
+			return *this;
+		}
+
+		template <typename T>
+		SettingsStore& set(const std::string& key, T value)
+		{
+			Value v = normalize(std::move(value));
+			{
+				std::lock_guard<std::mutex> lock(mtx_);
+				auto it = values_.find(key);
+				if (it != values_.end() and it->second == v)
+					return *this;
+				values_[key] = std::move(v);
+				dirty_ = true;
+				last_change_ = std::chrono::steady_clock::now();
+				if (not writer_.joinable() and not stop_)
+					writer_ = std::thread([this] { writerLoop(); });
+			}
+			cv_.notify_one();
+			return *this;
+		}
+
+		SettingsStore& erase(const std::string& key)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mtx_);
+				if (values_.erase(key) == 0)
+					return *this;
+				dirty_ = true;
+				last_change_ = std::chrono::steady_clock::now();
+				if (not writer_.joinable() and not stop_)
+					writer_ = std::thread([this] { writerLoop(); });
+			}
+			cv_.notify_one();
+			return *this;
+		}
+
+		bool contains(const std::string& key) const
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			return values_.contains(key);
+		}
+
+		std::optional<Value> get(const std::string& key) const
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			auto it = values_.find(key);
+			if (it == values_.end())
+				return std::nullopt;
+			return it->second;
+		}
+
+		// numbers convert between int and float, anything else falls back
+		bool getBool(const std::string& key, bool fallback = false) const
+		{
+			auto v = get(key);
+			if (v and std::holds_alternative<bool>(*v)) return std::get<bool>(*v);
+			return fallback;
+		}
+
+		int64_t getInt(const std::string& key, int64_t fallback = 0) const
+		{
+			auto v = get(key);
+			if (not v) return fallback;
+			if (std::holds_alternative<int64_t>(*v)) return std::get<int64_t>(*v);
+			if (std::holds_alternative<double>(*v)) return static_cast<int64_t>(std::get<double>(*v));
+			return fallback;
+		}
+
+		double getFloat(const std::string& key, double fallback = 0.0) const
+		{
+			auto v = get(key);
+			if (not v) return fallback;
+			if (std::holds_alternative<double>(*v)) return std::get<double>(*v);
+			if (std::holds_alternative<int64_t>(*v)) return static_cast<double>(std::get<int64_t>(*v));
+			return fallback;
+		}
+
+		std::string getString(const std::string& key, const std::string& fallback = {}) const
+		{
+			auto v = get(key);
+			if (v and std::holds_alternative<std::string>(*v)) return std::get<std::string>(*v);
+			return fallback;
+		}
+
+		bool isDirty() const
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			return dirty_;
+		}
+
+		// Writes pending changes now, on the calling thread. False when the
+		// write failed; the changes stay pending for the next attempt.
+		bool flush()
+		{
+			std::unique_lock<std::mutex> lock(mtx_);
+			return writePending(lock);
+		}
+
+	private:
+		template <typename T>
+		static Value normalize(T value)
+		{
+			using U = std::decay_t<T>;
+			if constexpr (std::is_same_v<U, bool>) return Value{ value };
+			else if constexpr (std::is_integral_v<U>) return Value{ static_cast<int64_t>(value) };
+			else if constexpr (std::is_floating_point_v<U>) return Value{ static_cast<double>(value) };
+			else return Value{ std::string(value) };
+		}
+
+		void writerLoop()
+		{
+			std::unique_lock<std::mutex> lock(mtx_);
+			while (not stop_) {
+				if (not dirty_) {
+					cv_.wait(lock);
+					continue;
+				}
+				// every new change pushes the deadline back
+				const auto due = last_change_ + quiet_;
+				if (std::chrono::steady_clock::now() < due) {
+					cv_.wait_until(lock, due);
+					continue;
+				}
+				writePending(lock);
+				if (dirty_) // write failed and nothing changed since, retry after another quiet period
+					cv_.wait_for(lock, quiet_);
+			}
+		}
+
+		// called with the lock held, drops it for the disk I/O
+		bool writePending(std::unique_lock<std::mutex>& lock)
+		{
+			if (not dirty_ or path_.empty())
+				return true;
+			// one writer at a time, and the snapshot is taken once it's our turn
+			// so an older snapshot can never land after a newer one
+			lock.unlock();
+			std::lock_guard<std::mutex> io(io_mtx_);
+			lock.lock();
+			if (not dirty_ or path_.empty())
+				return true;
+			const std::string text = serialize();
+			const std::string path = path_;
+			const auto stamp = last_change_;
+			dirty_ = false;
+			lock.unlock();
+			const bool ok = writeAtomic(path, text);
+			lock.lock();
+			if (not ok and last_change_ == stamp)
+				dirty_ = true;
+			return ok;
+		}
+
+		static bool writeAtomic(const std::string& path, const std::string& text)
+		{
+			const std::string tmp = path + ".tmp";
+			{
+				std::ofstream out(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+				if (not out.is_open())
+					return false;
+				out.write(text.data(), static_cast<std::streamsize>(text.size()));
+				out.flush();
+				if (not out)
+					return false;
+			}
+			std::error_code ec;
+			std::filesystem::rename(tmp, path, ec);
+			if (ec) {
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+			return true;
+		}
+
+		std::string serialize() const
+		{
+			std::string out;
+			char num[32];
+			for (const auto& [key, value] : values_) {
+				if (std::holds_alternative<bool>(value)) {
+					out += "b ", appendEscaped(out, key, true), out += std::get<bool>(value) ? "=1" : "=0";
+				}
+				else if (std::holds_alternative<int64_t>(value)) {
+					auto r = std::to_chars(num, num + sizeof(num), std::get<int64_t>(value));
+					out += "i ", appendEscaped(out, key, true), out += '=', out.append(num, r.ptr);
+				}
+				else if (std::holds_alternative<double>(value)) {
+					auto r = std::to_chars(num, num + sizeof(num), std::get<double>(value));
+					out += "f ", appendEscaped(out, key, true), out += '=', out.append(num, r.ptr);
+				}
+				else {
+					out += "s ", appendEscaped(out, key, true), out += '=';
+					appendEscaped(out, std::get<std::string>(value), false);
+				}
+				out += '\n';
+			}
+			return out;
+		}
+
+		void parseLine(std::string_view line)
+		{
+			if (not line.empty() and line.back() == '\r')
+				line.remove_suffix(1);
+			if (line.starts_with("winpos:")) {
+				line.remove_prefix(7);
+				const auto sep = line.find(':');
+				int64_t x = 0, y = 0;
+				if (sep != std::string_view::npos and parseInt(line.substr(0, sep), x) and parseInt(line.substr(sep + 1), y)) {
+					values_["window.x"] = x;
+					values_["window.y"] = y;
+				}
+				return;
+			}
+			if (line.size() < 3 or line[1] != ' ')
+				return;
+			const char type = line[0];
+			line.remove_prefix(2);
+			// the first = not escaped ends the key
+			std::size_t eq = 0;
+			while (eq < line.size() and line[eq] != '=')
+				eq += line[eq] == '\\' ? 2 : 1;
+			if (eq >= line.size() or eq == 0)
+				return;
+			std::string key = unescape(line.substr(0, eq));
+			const std::string_view raw = line.substr(eq + 1);
+			switch (type) {
+			case 'b':
+				values_[key] = raw == "1";
+				break;
+			case 'i': {
+				int64_t v = 0;
+				if (parseInt(raw, v)) values_[key] = v;
+				break;
+			}
+			case 'f': {
+				double v = 0.0;
+				auto r = std::from_chars(raw.data(), raw.data() + raw.size(), v);
+				if (r.ec == std::errc()) values_[key] = v;
+				break;
+			}
+			case 's':
+				values_[key] = unescape(raw);
+				break;
+			default:
+				break;
+			}
+		}
+
+		static void appendEscaped(std::string& out, std::string_view s, bool key)
+		{
+			for (char c : s) {
+				if (c == '\n') out += "\\n";
+				else if (c == '\r') out += "\\r";
+				else if (c == '\\') out += "\\\\";
+				else if (c == '=' and key) out += "\\=";
+				else out += c;
+			}
+		}
+
+		static std::string unescape(std::string_view raw)
+		{
+			std::string v;
+			v.reserve(raw.size());
+			for (std::size_t i = 0; i < raw.size(); ++i) {
+				if (raw[i] == '\\' and i + 1 < raw.size()) {
+					const char e = raw[++i];
+					v += e == 'n' ? '\n' : e == 'r' ? '\r' : e;
+				}
+				else v += raw[i];
+			}
+			return v;
+		}
+
+		static bool parseInt(std::string_view s, int64_t& out)
+		{
+			auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+			return r.ec == std::errc() and r.ptr == s.data() + s.size();
+		}
+
+		mutable std::mutex mtx_;
+		std::mutex io_mtx_;
+		std::condition_variable cv_;
+		std::thread writer_;
+		std::map<std::string, Value> values_;
+		std::string path_;
+		std::chrono::milliseconds quiet_{ 500 };
+		std::chrono::steady_clock::time_point last_change_{};
+		bool dirty_ = false;
+		bool stop_ = false;
+	};
+
+} // namespace Volt
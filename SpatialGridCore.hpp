@@ -0,0 +1,168 @@
+#pragma once
+// SpatialGridCore.hpp -- uniform grid over rectangles for point queries, zero SDL/framework dependency.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Spatial {
+
+	struct Rect {
+		float x = 0.f, y = 0.f, w = 0.f, h = 0.f;
+
+		bool contains(float px, float py) const
+		{
+			return px >= x && px < x + w && py >= y && py < y + h;
+		}
+	};
+
+	// Buckets rectangles into square cells so a point query only looks at the
+	// items overlapping one cell. Items covering more than MaxCellsPerItem
+	// cells (backgrounds, full screen containers) go to a short list that is
+	// checked on every query instead of being copied into hundreds of cells.
+	// z orders overlapping hits, higher z is on top.
+	template <typename T>
+	class UniformGrid {
+	public:
+		static constexpr int MaxCellsPerItem = 64;
+
+		struct Entry {
+			T item;
+			Rect rect;
+			int z = 0;
+		};
+
+		// Replaces the content. The cell size follows the average item size so
+		// a typical item touches about four cells.
+		void rebuild(std::vector<Entry> entries)
+		{
+			entries_ = std::move(entries);
+			finish();
+		}
+
+		// Same as rebuild() without handing over a vector: add() the items
+		// between begin() and finish(). Entry and bucket storage is kept, so
+		// rebuilding the same kind of content allocates nothing.
+		void begin() { entries_.clear(); }
+
+		void add(const T& item, const Rect& rect, int z = 0) { entries_.push_back({ item, rect, z }); }
+
+		void finish()
+		{
+			large_.clear();
+			double sum = 0.0;
+			std::size_t counted = 0;
+			for (const auto& e : entries_) {
+				if (e.rect.w <= 0.f || e.rect.h <= 0.f) continue;
+				sum += std::max(e.rect.w, e.rect.h);
+				++counted;
+			}
+			const float cell = counted ? std::clamp(static_cast<float>(sum / counted), 8.f, 1024.f) : 64.f;
+			// keep the cell size, and with it the bucket keys, unless the items changed a lot
+			if (cell < cell_ * 0.5f || cell > cell_ * 2.f) {
+				cell_ = cell;
+				buckets_.clear();
+			}
+			else {
+				for (auto& [key, bucket] : buckets_)
+					bucket.clear();
+			}
+			for (uint32_t i = 0; i < entries_.size(); ++i)
+				place(i);
+		}
+
+		void clear()
+		{
+			entries_.clear();
+			buckets_.clear();
+			large_.clear();
+		}
+
+		std::size_t size() const { return entries_.size(); }
+
+		float cellSize() const { return cell_; }
+
+		// Every item containing (x, y), topmost first, written over out. Reuses
+		// out's and the grid's scratch storage, so one grid can't be queried
+		// from two threads at once.
+		void query(float x, float y, std::vector<T>& out) const
+		{
+			hits_.clear();
+			forEachAt(x, y, [this](uint32_t i) { hits_.push_back(i); });
+			// ties keep insertion order reversed, later inserted is drawn on top
+			std::sort(hits_.begin(), hits_.end(), [this](uint32_t a, uint32_t b) { return above(a, b); });
+			out.clear();
+			for (uint32_t i : hits_) out.push_back(entries_[i].item);
+		}
+
+		std::vector<T> query(float x, float y) const
+		{
+			std::vector<T> out;
+			query(x, y, out);
+			return out;
+		}
+
+		std::optional<T> topmost(float x, float y) const
+		{
+			bool found = false;
+			uint32_t best = 0;
+			forEachAt(x, y, [&](uint32_t i) {
+				if (!found || above(i, best)) best = i, found = true;
+				});
+			if (!found) return std::nullopt;
+			return entries_[best].item;
+		}
+
+	private:
+		int cellOf(float v) const { return static_cast<int>(std::floor(v / cell_)); }
+
+		static int64_t key(int cx, int cy)
+		{
+			return (static_cast<int64_t>(cx) << 32) ^ static_cast<uint32_t>(cy);
+		}
+
+		bool above(uint32_t a, uint32_t b) const
+		{
+			if (entries_[a].z != entries_[b].z) return entries_[a].z > entries_[b].z;
+			return a > b;
+		}
+
+		template <typename Visit>
+		void forEachAt(float x, float y, Visit&& visit) const
+		{
+			auto it = buckets_.find(key(cellOf(x), cellOf(y)));
+			if (it != buckets_.end()) {
+				for (uint32_t i : it->second)
+					if (entries_[i].rect.contains(x, y)) visit(i);
+			}
+			for (uint32_t i : large_)
+				if (entries_[i].rect.contains(x, y)) visit(i);
+		}
+
+		void place(uint32_t i)
+		{
+			const Rect& r = entries_[i].rect;
+			if (r.w <= 0.f || r.h <= 0.f) return;
+			const int x0 = cellOf(r.x), y0 = cellOf(r.y);
+			const int x1 = cellOf(r.x + r.w), y1 = cellOf(r.y + r.h);
+			if (static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > MaxCellsPerItem) {
+				large_.push_back(i);
+				return;
+			}
+			for (int cy = y0; cy <= y1; ++cy)
+				for (int cx = x0; cx <= x1; ++cx)
+					buckets_[key(cx, cy)].push_back(i);
+		}
+
+		std::vector<Entry> entries_;
+		std::unordered_map<int64_t, std::vector<uint32_t>> buckets_;
+		std::vector<uint32_t> large_;
+		mutable std::vector<uint32_t> hits_;
+		float cell_ = 64.f;
+	};
+
+} // namespace Spatial
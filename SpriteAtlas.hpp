@@ -0,0 +1,370 @@
+#pragma once
+// SpriteAtlas.hpp -- packs small images (icons) into shared atlas pages and batches their draws.
+//  - images are staged with addImage/addDirectory/addManifest and packed with pack().
+//    pack(export_dir) additionally writes the pages + an index so that loadPacked(export_dir)
+//    can skip the packing step on the next start (or ship the packed output instead of the icons).
+//  - addDirectory relies on std::filesystem, on Android (apk assets) use a manifest instead.
+//  - between beginBatch()/endBatch() submitted regions are collected per page and flushed with a
+//    single SDL_RenderGeometry call per page. regions from different pages are not depth sorted
+//    against each other, don't rely on overlapping icons from different pages inside one batch.
+// -----------------------------------------------------------------------------
+
+#include "SpriteAtlasCore.hpp"
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AtlasRegion
+{
+	SDL_Texture *page = nullptr;
+	// region in page pixels
+	SDL_FRect src = {0.f, 0.f, 0.f, 0.f};
+	int page_index = -1;
+};
+
+class SpriteAtlas : public Context
+{
+public:
+	SpriteAtlas(const SpriteAtlas &) = delete;
+	SpriteAtlas(const SpriteAtlas &&) = delete;
+
+	static SpriteAtlas &Get()
+	{
+		static SpriteAtlas instance{};
+		return instance;
+	}
+
+	void init(Context *_cntx)
+	{
+		Context::setContext(_cntx);
+	}
+
+	SpriteAtlas &setPageSize(int _page_size)
+	{
+		page_size_ = std::max(_page_size, 64);
+		return *this;
+	}
+
+	SpriteAtlas &setPadding(int _padding)
+	{
+		padding_ = std::max(_padding, 0);
+		return *this;
+	}
+
+	// images larger than this (on either axis) are not worth packing and are skipped by addDirectory
+	SpriteAtlas &setMaxSpriteSize(int _max_sprite_size)
+	{
+		max_sprite_size_ = std::max(_max_sprite_size, 1);
+		return *this;
+	}
+
+	// takes ownership of _surface
+	bool addSurface(const std::string &_name, SDL_Surface *_surface)
+	{
+		if (_surface == nullptr)
+			return false;
+		if (_surface->w + padding_ > page_size_ or _surface->h + padding_ > page_size_)
+		{
+			GLogger.Log(Logger::Level::Warning, "SpriteAtlas: sprite", _name, "is larger than the atlas page, skipped");
+			SDL_DestroySurface(_surface);
+			return false;
+		}
+		staged_.emplace_back(_name, _surface);
+		return true;
+	}
+
+	bool addImage(const std::string &_name, const std::string &_path)
+	{
+		SDL_Surface *surface = IMG_Load(_path.c_str());
+		if (surface == nullptr)
+		{
+			GLogger.Log(Logger::Level::Error, "SpriteAtlas: couldn't load", _path, ":", SDL_GetError());
+			return false;
+		}
+		return addSurface(_name, surface);
+	}
+
+	// stages every loadable image in _dir, the region name is the file name without extension
+	std::size_t addDirectory(const std::string &_dir)
+	{
+		std::size_t added = 0;
+		std::error_code ec;
+		for (const auto &entry : std::filesystem::directory_iterator(_dir, ec))
+		{
+			if (not entry.is_regular_file())
+				continue;
+			SDL_Surface *surface = IMG_Load(entry.path().string().c_str());
+			if (surface == nullptr)
+				continue;
+			if (surface->w > max_sprite_size_ or surface->h > max_sprite_size_)
+			{
+				SDL_DestroySurface(surface);
+				continue;
+			}
+			added += addSurface(entry.path().stem().string(), surface) ? 1 : 0;
+		}
+		if (ec)
+			GLogger.Log(Logger::Level::Error, "SpriteAtlas: couldn't read directory", _dir, ":", ec.message());
+		return added;
+	}
+
+	// manifest lines are "name=path", paths are relative to the manifest. empty lines and lines starting with '#' are ignored
+	std::size_t addManifest(const std::string &_manifest_path)
+	{
+		std::ifstream manifest(_manifest_path);
+		if (not manifest.is_open())
+		{
+			GLogger.Log(Logger::Level::Error, "SpriteAtlas: failed to open manifest:", _manifest_path);
+			return 0;
+		}
+		const auto base = std::filesystem::path(_manifest_path).parent_path();
+		std::size_t added = 0;
+		std::string line;
+		while (std::getline(manifest, line))
+		{
+			if (line.empty() or line[0] == '#')
+				continue;
+			const auto eq = line.find('=');
+			if (eq == std::string::npos)
+				continue;
+			added += addImage(line.substr(0, eq), (base / line.substr(eq + 1)).string()) ? 1 : 0;
+		}
+		return added;
+	}
+
+	/**
+	 * Packs the staged images into new atlas pages and uploads them.
+	 * if _export_dir is given, the pages are also written there as atlas_<n>.png together
+	 * with an atlas.txt index (name:page:x:y:w:h) readable by loadPacked.
+	 */
+	bool pack(const std::string &_export_dir = "")
+	{
+		if (staged_.empty())
+			return true;
+		std::vector<AtlasPack::Item> items;
+		items.reserve(staged_.size());
+		for (std::size_t i = 0; i < staged_.size(); ++i)
+			items.push_back({i, staged_[i].second->w, staged_[i].second->h});
+		int page_count = 0;
+		const auto placements = AtlasPack::packShelves(items, page_size_, page_size_, padding_, page_count);
+
+		std::vector<SDL_Surface *> page_surfaces(page_count, nullptr);
+		for (auto &ps : page_surfaces)
+		{
+			ps = SDL_CreateSurface(page_size_, page_size_, SDL_PIXELFORMAT_RGBA32);
+			if (ps == nullptr)
+			{
+				GLogger.Log(Logger::Level::Error, "SpriteAtlas: couldn't create page:", SDL_GetError());
+				for (auto *p : page_surfaces)
+					if (p != nullptr)
+						SDL_DestroySurface(p);
+				clearStaged();
+				return false;
+			}
+			SDL_FillSurfaceRect(ps, nullptr, 0);
+		}
+
+		const int first_page = (int)pages_.size();
+		for (const auto &pl : placements)
+		{
+			if (pl.page < 0)
+				continue;
+			auto &[name, surface] = staged_[pl.id];
+			SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+			SDL_Rect dst{pl.x, pl.y, pl.w, pl.h};
+			SDL_BlitSurface(surface, nullptr, page_surfaces[pl.page], &dst);
+			regions_[name] = {first_page + pl.page, SDL_FRect{(float)pl.x, (float)pl.y, (float)pl.w, (float)pl.h}};
+		}
+
+		std::ofstream index;
+		if (not _export_dir.empty())
+		{
+			// each export describes only this pack, with its own page numbers, so loadPacked can read it back on its own
+			index.open((std::filesystem::path(_export_dir) / "atlas.txt").string(), std::ios::out | std::ios::trunc);
+			for (const auto &pl : placements)
+				if (pl.page >= 0)
+					index << staged_[pl.id].first << ":" << pl.page << ":" << pl.x << ":" << pl.y << ":" << pl.w << ":" << pl.h << "\n";
+		}
+
+		for (int p = 0; p < page_count; ++p)
+		{
+			if (not _export_dir.empty())
+				IMG_SavePNG(page_surfaces[p], (std::filesystem::path(_export_dir) / ("atlas_" + std::to_string(p) + ".png")).string().c_str());
+			addPage(CreateSharedTextureFromSurface(renderer, page_surfaces[p]));
+			SDL_DestroySurface(page_surfaces[p]);
+		}
+		GLogger.Log(Logger::Level::Info, "SpriteAtlas: packed", staged_.size(), "sprites into", page_count, "page(s)");
+		clearStaged();
+		return true;
+	}
+
+	// loads pages and regions written by pack(_export_dir)
+	bool loadPacked(const std::string &_dir)
+	{
+		std::ifstream index((std::filesystem::path(_dir) / "atlas.txt").string());
+		if (not index.is_open())
+		{
+			GLogger.Log(Logger::Level::Error, "SpriteAtlas: failed to open", _dir + "/atlas.txt");
+			return false;
+		}
+		const int first_page = (int)pages_.size();
+		int page_count = 0;
+		std::string line;
+		while (std::getline(index, line))
+		{
+			std::stringstream ss(line);
+			std::string segment;
+			std::vector<std::string> values;
+			while (std::getline(ss, segment, ':'))
+				values.push_back(segment);
+			if (values.size() < 6)
+				continue;
+			const int page = std::atoi(values[1].c_str());
+			page_count = std::max(page_count, page + 1);
+			regions_[values[0]] = {first_page + page, SDL_FRect{(float)std::atof(values[2].c_str()), (float)std::atof(values[3].c_str()),
+																(float)std::atof(values[4].c_str()), (float)std::atof(values[5].c_str())}};
+		}
+		for (int p = 0; p < page_count; ++p)
+		{
+			auto page = LoadSharedTexture(renderer, (std::filesystem::path(_dir) / ("atlas_" + std::to_string(p) + ".png")).string());
+			if (page == nullptr)
+				GLogger.Log(Logger::Level::Error, "SpriteAtlas: couldn't load page", p, ":", SDL_GetError());
+			addPage(std::move(page));
+		}
+		return true;
+	}
+
+	bool contains(const std::string &_name) const
+	{
+		return regions_.contains(_name);
+	}
+
+	std::optional<AtlasRegion> find(const std::string &_name) const
+	{
+		auto it = regions_.find(_name);
+		if (it == regions_.end() or it->second.first >= (int)pages_.size() or pages_[it->second.first].texture == nullptr)
+			return std::nullopt;
+		return AtlasRegion{pages_[it->second.first].texture.get(), it->second.second, it->second.first};
+	}
+
+	std::size_t pageCount() const noexcept
+	{
+		return pages_.size();
+	}
+
+	void beginBatch()
+	{
+		++batch_depth_;
+	}
+
+	void endBatch()
+	{
+		if (batch_depth_ > 0 and --batch_depth_ == 0)
+			flush();
+	}
+
+	// draws _region into _dst. inside a batch the quad is deferred until the batch ends (or the render target changes)
+	void submit(const AtlasRegion &_region, const SDL_FRect &_dst)
+	{
+		if (_region.page == nullptr)
+			return;
+		if (batch_depth_ == 0 or _region.page_index < 0 or _region.page_index >= (int)pages_.size())
+		{
+			RenderTexture(renderer, _region.page, &_region.src, &_dst);
+			return;
+		}
+		SDL_Texture *target = SDL_GetRenderTarget(renderer);
+		if (pending_quads_ > 0 and target != batch_target_)
+			flush();
+		batch_target_ = target;
+
+		auto &pg = pages_[_region.page_index];
+		const float iw = 1.f / (float)pg.w, ih = 1.f / (float)pg.h;
+		const float u0 = _region.src.x * iw, v0 = _region.src.y * ih;
+		const float u1 = (_region.src.x + _region.src.w) * iw, v1 = (_region.src.y + _region.src.h) * ih;
+		const SDL_FColor white{1.f, 1.f, 1.f, 1.f};
+		const int base = (int)pg.vertices.size();
+		pg.vertices.push_back({{_dst.x, _dst.y}, white, {u0, v0}});
+		pg.vertices.push_back({{_dst.x + _dst.w, _dst.y}, white, {u1, v0}});
+		pg.vertices.push_back({{_dst.x + _dst.w, _dst.y + _dst.h}, white, {u1, v1}});
+		pg.vertices.push_back({{_dst.x, _dst.y + _dst.h}, white, {u0, v1}});
+		pg.indices.insert(pg.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+		++pending_quads_;
+	}
+
+	// one SDL_RenderGeometry call per page that received quads
+	void flush()
+	{
+		if (pending_quads_ == 0)
+			return;
+		CacheRenderTarget crt_(renderer);
+		if (SDL_GetRenderTarget(renderer) != batch_target_)
+			SDL_SetRenderTarget(renderer, batch_target_);
+		for (auto &pg : pages_)
+		{
+			if (pg.vertices.empty())
+				continue;
+			SDL_RenderGeometry(renderer, pg.texture.get(), pg.vertices.data(), (int)pg.vertices.size(), pg.indices.data(), (int)pg.indices.size());
+			pg.vertices.clear();
+			pg.indices.clear();
+		}
+		crt_.release(renderer);
+		pending_quads_ = 0;
+	}
+
+	void reset()
+	{
+		clearStaged();
+		pages_.clear();
+		regions_.clear();
+		pending_quads_ = 0;
+		batch_depth_ = 0;
+		batch_target_ = nullptr;
+	}
+
+private:
+	SpriteAtlas() = default;
+
+	struct Page
+	{
+		SharedTexture texture = nullptr;
+		float w = 1.f, h = 1.f;
+		std::vector<SDL_Vertex> vertices{};
+		std::vector<int> indices{};
+	};
+
+	void addPage(SharedTexture _texture)
+	{
+		Page page{};
+		if (_texture != nullptr)
+		{
+			SDL_SetTextureBlendMode(_texture.get(), SDL_BLENDMODE_BLEND);
+			SDL_GetTextureSize(_texture.get(), &page.w, &page.h);
+		}
+		page.texture = std::move(_texture);
+		pages_.push_back(std::move(page));
+	}
+
+	void clearStaged()
+	{
+		for (auto &[name, surface] : staged_)
+			SDL_DestroySurface(surface);
+		staged_.clear();
+	}
+
+private:
+	std::vector<std::pair<std::string, SDL_Surface *>> staged_{};
+	std::vector<Page> pages_{};
+	// name -> <page, src rect>
+	std::unordered_map<std::string, std::pair<int, SDL_FRect>> regions_{};
+	SDL_Texture *batch_target_ = nullptr;
+	std::size_t pending_quads_ = 0;
+	int batch_depth_ = 0;
+	int page_size_ = 2048;
+	int padding_ = 1;
+	int max_sprite_size_ = 256;
+};
@@ -0,0 +1,88 @@
+#pragma once
+// SpriteAtlasCore.hpp -- shelf rect packer used by SpriteAtlas, zero SDL/framework dependency.
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace AtlasPack {
+
+	struct Item {
+		std::size_t id = 0; // caller defined, copied to the matching Placement
+		int w = 0;
+		int h = 0;
+	};
+
+	struct Placement {
+		std::size_t id = 0;
+		int page = -1;      // -1 when the item can't fit on an empty page
+		int x = 0, y = 0, w = 0, h = 0;
+	};
+
+	struct Shelf {
+		int page = 0;
+		int y = 0;          // top of the shelf
+		int h = 0;          // height of the tallest item that opened it
+		int cursor = 0;     // next free x
+	};
+
+	// Packs items into as many page_w x page_h pages as needed.
+	// Items are sorted tallest first and placed on the first shelf (of any
+	// open page) with room left; a new shelf is opened below the last one and
+	// a new page once the current page is full. padding is added on the
+	// right/bottom of every item so that linear filtering doesn't bleed
+	// neighbours in. Returns the placements in input order, pageCount receives
+	// the number of pages used.
+	inline std::vector<Placement> packShelves(const std::vector<Item>& items, int page_w, int page_h,
+		int padding, int& pageCount)
+	{
+		std::vector<std::size_t> order(items.size());
+		for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&items](std::size_t a, std::size_t b) {
+			if (items[a].h != items[b].h) return items[a].h > items[b].h;
+			return items[a].w > items[b].w;
+			});
+
+		std::vector<Placement> out(items.size());
+		std::vector<Shelf> shelves;
+		std::vector<int> pageBottom; // first free y per page
+		pageCount = 0;
+
+		for (std::size_t idx : order) {
+			const Item& it = items[idx];
+			Placement& pl = out[idx];
+			pl.id = it.id;
+			pl.w = it.w;
+			pl.h = it.h;
+			const int pw = it.w + padding, ph = it.h + padding;
+			if (it.w <= 0 || it.h <= 0 || pw > page_w || ph > page_h)
+				continue;
+
+			bool placed = false;
+			for (Shelf& s : shelves) {
+				if (ph <= s.h && s.cursor + pw <= page_w) {
+					pl.page = s.page, pl.x = s.cursor, pl.y = s.y;
+					s.cursor += pw;
+					placed = true;
+					break;
+				}
+			}
+			if (placed) continue;
+
+			// open a new shelf on the first page with vertical room left
+			int page = -1;
+			for (int p = 0; p < pageCount; ++p) {
+				if (pageBottom[p] + ph <= page_h) { page = p; break; }
+			}
+			if (page < 0) {
+				page = pageCount++;
+				pageBottom.push_back(0);
+			}
+			shelves.push_back({ page, pageBottom[page], ph, pw });
+			pageBottom[page] += ph;
+			pl.page = page, pl.x = 0, pl.y = shelves.back().y;
+		}
+		return out;
+	}
+
+} // namespace AtlasPack
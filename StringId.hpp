@@ -0,0 +1,108 @@
+#pragma once
+// StringId.hpp -- interned strings, zero SDL/framework dependency.
+//
+// A StringId is a 32-bit index into a process wide, append-only table, so
+// views carrying a label/type/action/id pay 4 bytes each instead of a
+// std::string, and comparing two ids is an integer compare. Interning takes
+// a lock and a hash lookup, reading the text back only a shared lock. Interned text
+// is never freed, meant for the small vocabulary of names a UI uses, not
+// for user content.
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Volt {
+
+	class StringId {
+	public:
+		StringId() = default;
+		StringId(const char* s) : value_(s ? intern(s) : 0) {}
+		StringId(const std::string& s) : value_(intern(s)) {}
+		StringId(std::string_view s) : value_(intern(s)) {}
+
+		const std::string& str() const { return Table::Get().at(value_); }
+		const char* c_str() const { return str().c_str(); }
+		operator const std::string&() const { return str(); }
+
+		bool empty() const { return value_ == 0; }
+		uint32_t value() const { return value_; }
+
+		bool operator==(const StringId& other) const { return value_ == other.value_; }
+		// compared as text, nothing gets interned
+		bool operator==(const char* s) const { return str() == s; }
+		bool operator==(const std::string& s) const { return str() == s; }
+
+		// number of distinct strings interned so far, "" included
+		static std::size_t internedCount() { return Table::Get().size(); }
+
+	private:
+		// slot 0 is the empty string; std::deque keeps the stored strings in
+		// place as the table grows, the map keys view into them
+		class Table {
+		public:
+			static Table& Get()
+			{
+				static Table instance;
+				return instance;
+			}
+
+			uint32_t intern(std::string_view s)
+			{
+				if (s.empty())
+					return 0;
+				{
+					std::shared_lock<std::shared_mutex> lock(mtx_);
+					auto it = index_.find(s);
+					if (it != index_.end())
+						return it->second;
+				}
+				std::unique_lock<std::shared_mutex> lock(mtx_);
+				auto it = index_.find(s);
+				if (it != index_.end())
+					return it->second;
+				const uint32_t id = static_cast<uint32_t>(strings_.size());
+				const std::string& stored = strings_.emplace_back(s);
+				index_.emplace(std::string_view(stored), id);
+				return id;
+			}
+
+			const std::string& at(uint32_t id)
+			{
+				std::shared_lock<std::shared_mutex> lock(mtx_);
+				return strings_[id];
+			}
+
+			std::size_t size()
+			{
+				std::shared_lock<std::shared_mutex> lock(mtx_);
+				return strings_.size();
+			}
+
+		private:
+			Table() { strings_.emplace_back(); }
+
+			std::shared_mutex mtx_;
+			std::deque<std::string> strings_;
+			std::unordered_map<std::string_view, uint32_t> index_;
+		};
+
+		static uint32_t intern(std::string_view s) { return Table::Get().intern(s); }
+
+		uint32_t value_ = 0;
+	};
+
+	inline std::ostream& operator<<(std::ostream& os, const StringId& id) { return os << id.str(); }
+
+} // namespace Volt
+
+template <>
+struct std::hash<Volt::StringId> {
+	std::size_t operator()(const Volt::StringId& id) const noexcept { return std::hash<uint32_t>{}(id.value()); }
+};
@@ -0,0 +1,692 @@
+#pragma once
+// UiBlobCore.hpp -- compiled UI descriptions, zero SDL dependency.
+//
+// A screen is described as indented text, one node per line:
+//
+//	# settings screen
+//	column name=root padding=16 gap=8
+//	  row height=48 align=center gap=12
+//	    text name=title text="Settings" grow=1 font-size=22 fg=#202020
+//	    toggle name=wifi width=64 height=32 on
+//	  column name=advanced hidden
+//	    slider name=volume height=24 min=0 max=100 value=40
+//
+// The first word is the node type, then key=value pairs or bare flags.
+// Layout keys (width, grow, padding, ...; see styleKey()) fold into a
+// Layout::Style, "hidden" (or hidden=true) marks a subtree that is only built
+// on demand and everything else is kept as a typed attribute (number,
+// #rrggbb[aa] color, true/false, "quoted" or bare string) for the widget
+// factory. Every attribute also keeps its value as written, so text=404
+// still reads back as "404".
+//
+// Compiler turns that text into a blob: one header and four flat tables
+// (nodes in pre-order, attributes, types, a NUL separated string pool) with
+// 4 byte aligned little-endian records. Reader validates a blob once and then
+// reads it in place, strings come back as views into it, so a memory-mapped
+// file is used without parsing or copying. Every node carries the index one
+// past its subtree and its slot among nodes of the same type; with the
+// per-type counts a loader can size its storage up front and skip a whole
+// hidden subtree in O(1).
+//
+// Build VOLT_UIC_MAIN into one translation unit for the offline compiler:
+//	uic settings.vui settings.vuib
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LayoutCore.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace UiBlob {
+
+	static_assert(std::endian::native == std::endian::little, "UI blobs are little-endian");
+
+	inline constexpr char Magic[4] = { 'V', 'U', 'I', 'B' };
+	inline constexpr uint32_t Version = 2;
+	inline constexpr uint32_t NoNode = UINT32_MAX;
+
+	enum NodeFlags : uint16_t {
+		NodeHidden = 1 << 0, // subtree is built on demand
+	};
+
+	enum class AttrKind : uint32_t { Number, String, Color, Bool };
+
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t node_count, attr_count, type_count;
+		uint32_t nodes_offset, attrs_offset, types_offset, strings_offset, strings_size;
+		uint32_t total_size;
+	};
+
+	struct ValueRec {
+		uint32_t unit; // Layout::Value::Unit
+		float v;
+	};
+
+	struct StyleRec {
+		uint8_t direction, justify, align_items, align_self, position, pad_[3];
+		float grow, shrink, gap;
+		ValueRec basis, width, height, min_width, min_height, max_width, max_height;
+		float padding[4], margin[4]; // left, top, right, bottom
+		ValueRec inset[4];
+	};
+
+	struct NodeRec {
+		uint32_t type;      // index into the type table
+		uint32_t type_slot; // ordinal among the nodes of that type
+		uint32_t name;      // string offset, 0 is ""
+		uint32_t parent;    // NoNode for top level nodes
+		uint32_t end;       // one past the last node of the subtree
+		uint32_t first_attr;
+		uint16_t attr_count;
+		uint16_t flags;
+		StyleRec style;
+	};
+
+	struct AttrRec {
+		uint32_t key;  // string offset
+		AttrKind kind;
+		uint32_t bits; // float bits, string offset, 0xRRGGBBAA or 0/1
+		uint32_t text; // string offset of the value as written
+	};
+
+	struct TypeRec {
+		uint32_t name;  // string offset
+		uint32_t count; // nodes of this type
+	};
+
+	static_assert(sizeof(Header) == 44 and sizeof(NodeRec) % 4 == 0 and sizeof(AttrRec) == 16 and sizeof(TypeRec) == 8);
+
+	class Reader {
+	public:
+		// Checks the whole blob once, every accessor trusts it afterwards. The
+		// memory must stay valid and 4 byte aligned while the reader is used.
+		bool open(const void* data, std::size_t size, std::string* error = nullptr)
+		{
+			*this = Reader{};
+			auto fail = [error](const char* msg) {
+				if (error) *error = msg;
+				return false;
+			};
+			if (data == nullptr or size < sizeof(Header) or reinterpret_cast<uintptr_t>(data) % 4 != 0)
+				return fail("blob too small or misaligned");
+			const auto* base = static_cast<const std::byte*>(data);
+			const auto* h = reinterpret_cast<const Header*>(base);
+			if (std::memcmp(h->magic, Magic, 4) != 0) return fail("not a UI blob");
+			if (h->version != Version) return fail("unsupported UI blob version");
+			if (h->total_size != size) return fail("blob size mismatch");
+			auto section = [size](uint32_t offset, uint64_t bytes) {
+				return offset % 4 == 0 and offset >= sizeof(Header) and offset + bytes <= size;
+			};
+			if (not section(h->nodes_offset, uint64_t(h->node_count) * sizeof(NodeRec)) or
+				not section(h->attrs_offset, uint64_t(h->attr_count) * sizeof(AttrRec)) or
+				not section(h->types_offset, uint64_t(h->type_count) * sizeof(TypeRec)) or
+				not section(h->strings_offset, h->strings_size))
+				return fail("section out of bounds");
+			const char* strings = reinterpret_cast<const char*>(base + h->strings_offset);
+			if (h->strings_size == 0 or strings[h->strings_size - 1] != '\0')
+				return fail("string pool not terminated");
+			const auto* nodes = reinterpret_cast<const NodeRec*>(base + h->nodes_offset);
+			const auto* attrs = reinterpret_cast<const AttrRec*>(base + h->attrs_offset);
+			const auto* types = reinterpret_cast<const TypeRec*>(base + h->types_offset);
+			for (uint32_t t = 0; t < h->type_count; ++t)
+				if (types[t].name >= h->strings_size) return fail("bad type name");
+			for (uint32_t a = 0; a < h->attr_count; ++a) {
+				if (attrs[a].key >= h->strings_size or attrs[a].kind > AttrKind::Bool) return fail("bad attribute");
+				if (attrs[a].kind == AttrKind::String and attrs[a].bits >= h->strings_size) return fail("bad attribute string");
+				if (attrs[a].text >= h->strings_size) return fail("bad attribute text");
+			}
+			// pre-order: a node's parent is the innermost subtree still open at it,
+			// and its type slot is the next unused one of that type
+			std::vector<uint32_t> enclosing;
+			enclosing.reserve(16);
+			std::vector<uint32_t> next_slot(h->type_count, 0);
+			for (uint32_t i = 0; i < h->node_count; ++i) {
+				const NodeRec& n = nodes[i];
+				if (n.type >= h->type_count or n.type_slot != next_slot[n.type]++) return fail("bad node type");
+				if (n.name >= h->strings_size) return fail("bad node name");
+				if (n.end <= i or n.end > h->node_count) return fail("bad subtree range");
+				while (not enclosing.empty() and nodes[enclosing.back()].end <= i)
+					enclosing.pop_back();
+				if (n.parent != (enclosing.empty() ? NoNode : enclosing.back())) return fail("bad node parent");
+				if (not enclosing.empty() and n.end > nodes[enclosing.back()].end) return fail("bad subtree range");
+				enclosing.push_back(i);
+				if (uint64_t(n.first_attr) + n.attr_count > h->attr_count) return fail("bad attribute range");
+				if (not validStyle(n.style)) return fail("bad node style");
+			}
+			for (uint32_t t = 0; t < h->type_count; ++t)
+				if (next_slot[t] != types[t].count) return fail("bad type count");
+			header_ = h, nodes_ = nodes, attrs_ = attrs, types_ = types, strings_ = strings;
+			return true;
+		}
+
+		bool valid() const { return header_ != nullptr; }
+		uint32_t nodeCount() const { return header_ ? header_->node_count : 0; }
+		uint32_t typeCount() const { return header_ ? header_->type_count : 0; }
+
+		const NodeRec& node(uint32_t i) const { return nodes_[i]; }
+		std::string_view typeName(uint32_t t) const { return str(types_[t].name); }
+		uint32_t typeInstances(uint32_t t) const { return types_[t].count; }
+
+		std::string_view type(uint32_t i) const { return typeName(nodes_[i].type); }
+		std::string_view name(uint32_t i) const { return str(nodes_[i].name); }
+		bool hidden(uint32_t i) const { return nodes_[i].flags & NodeHidden; }
+
+		std::string_view str(uint32_t offset) const { return strings_ + offset; }
+
+		const AttrRec* attr(uint32_t i, std::string_view key) const
+		{
+			const NodeRec& n = nodes_[i];
+			for (uint32_t a = n.first_attr; a < n.first_attr + n.attr_count; ++a)
+				if (str(attrs_[a].key) == key) return &attrs_[a];
+			return nullptr;
+		}
+
+		// typed getters; a missing key or another kind gives the fallback,
+		// except text() which reads any kind back as written
+		float number(uint32_t i, std::string_view key, float fallback = 0.f) const
+		{
+			const AttrRec* a = attr(i, key);
+			return a and a->kind == AttrKind::Number ? std::bit_cast<float>(a->bits) : fallback;
+		}
+
+		std::string_view text(uint32_t i, std::string_view key, std::string_view fallback = {}) const
+		{
+			const AttrRec* a = attr(i, key);
+			return a ? str(a->text) : fallback;
+		}
+
+		uint32_t color(uint32_t i, std::string_view key, uint32_t fallback = 0x000000ff) const
+		{
+			const AttrRec* a = attr(i, key);
+			return a and a->kind == AttrKind::Color ? a->bits : fallback;
+		}
+
+		bool boolean(uint32_t i, std::string_view key, bool fallback = false) const
+		{
+			const AttrRec* a = attr(i, key);
+			return a and a->kind == AttrKind::Bool ? a->bits != 0 : fallback;
+		}
+
+		Layout::Style style(uint32_t i) const
+		{
+			const StyleRec& r = nodes_[i].style;
+			auto val = [](const ValueRec& v) { return Layout::Value{ static_cast<Layout::Value::Unit>(v.unit), v.v }; };
+			Layout::Style s;
+			s.direction = static_cast<Layout::Direction>(r.direction);
+			s.justify = static_cast<Layout::Justify>(r.justify);
+			s.align_items = static_cast<Layout::Align>(r.align_items);
+			s.align_self = static_cast<Layout::Align>(r.align_self);
+			s.position = static_cast<Layout::Position>(r.position);
+			s.grow = r.grow, s.shrink = r.shrink, s.gap = r.gap;
+			s.basis = val(r.basis), s.width = val(r.width), s.height = val(r.height);
+			s.min_width = val(r.min_width), s.min_height = val(r.min_height);
+			s.max_width = val(r.max_width), s.max_height = val(r.max_height);
+			s.padding = { r.padding[0], r.padding[1], r.padding[2], r.padding[3] };
+			s.margin = { r.margin[0], r.margin[1], r.margin[2], r.margin[3] };
+			s.inset = { val(r.inset[0]), val(r.inset[1]), val(r.inset[2]), val(r.inset[3]) };
+			return s;
+		}
+
+	private:
+		// enums in range, so style() never makes up an enumerator
+		static bool validStyle(const StyleRec& r)
+		{
+			constexpr uint32_t max_unit = static_cast<uint32_t>(Layout::Value::Unit::Percent);
+			for (const ValueRec* v : { &r.basis, &r.width, &r.height, &r.min_width, &r.min_height, &r.max_width, &r.max_height,
+									   &r.inset[0], &r.inset[1], &r.inset[2], &r.inset[3] })
+				if (v->unit > max_unit) return false;
+			return r.direction <= static_cast<uint8_t>(Layout::Direction::Column) and
+				r.justify <= static_cast<uint8_t>(Layout::Justify::SpaceEvenly) and
+				r.align_items <= static_cast<uint8_t>(Layout::Align::Stretch) and
+				r.align_self <= static_cast<uint8_t>(Layout::Align::Stretch) and
+				r.position <= static_cast<uint8_t>(Layout::Position::Absolute);
+		}
+
+		const Header* header_ = nullptr;
+		const NodeRec* nodes_ = nullptr;
+		const AttrRec* attrs_ = nullptr;
+		const TypeRec* types_ = nullptr;
+		const char* strings_ = nullptr;
+	};
+
+	class Compiler {
+	public:
+		// Text to blob; on failure out is untouched and error says "line N: ..."
+		bool compile(std::string_view source, std::vector<std::byte>& out, std::string* error = nullptr)
+		{
+			*this = Compiler{};
+			intern("");
+			std::vector<std::pair<int, uint32_t>> open; // indent, node
+			std::size_t line_no = 0;
+			while (not source.empty()) {
+				++line_no;
+				const std::size_t nl = source.find('\n');
+				std::string_view line = source.substr(0, nl);
+				source.remove_prefix(nl == std::string_view::npos ? source.size() : nl + 1);
+				if (not line.empty() and line.back() == '\r') line.remove_suffix(1);
+
+				int indent = 0;
+				std::size_t p = 0;
+				for (; p < line.size() and (line[p] == ' ' or line[p] == '\t'); ++p)
+					indent += line[p] == '\t' ? 4 : 1;
+				line.remove_prefix(p);
+				if (line.empty() or line[0] == '#')
+					continue;
+
+				while (not open.empty() and open.back().first >= indent) {
+					nodes_[open.back().second].end = static_cast<uint32_t>(nodes_.size());
+					open.pop_back();
+				}
+				const uint32_t parent = open.empty() ? NoNode : open.back().second;
+				if (not parseNode(line, parent, error_)) {
+					if (error) *error = "line " + std::to_string(line_no) + ": " + error_;
+					return false;
+				}
+				open.emplace_back(indent, static_cast<uint32_t>(nodes_.size() - 1));
+			}
+			for (auto& [indent, node] : open)
+				nodes_[node].end = static_cast<uint32_t>(nodes_.size());
+			if (nodes_.empty()) {
+				if (error) *error = "no nodes";
+				return false;
+			}
+			emit(out);
+			return true;
+		}
+
+	private:
+		static constexpr uint32_t Pct = static_cast<uint32_t>(Layout::Value::Unit::Percent);
+		static constexpr uint32_t Px = static_cast<uint32_t>(Layout::Value::Unit::Px);
+
+		struct Token {
+			std::string_view key;
+			std::string value; // unescaped
+			bool has_value = false, quoted = false;
+		};
+
+		uint32_t intern(std::string_view s)
+		{
+			auto it = string_index_.find(std::string(s));
+			if (it != string_index_.end()) return it->second;
+			const uint32_t offset = static_cast<uint32_t>(strings_.size());
+			strings_.append(s).push_back('\0');
+			string_index_.emplace(std::string(s), offset);
+			return offset;
+		}
+
+		static bool tokenize(std::string_view line, std::vector<Token>& tokens, std::string& error)
+		{
+			std::size_t i = 0;
+			while (i < line.size()) {
+				if (line[i] == ' ' or line[i] == '\t') { ++i; continue; }
+				Token t;
+				const std::size_t start = i;
+				while (i < line.size() and line[i] != '=' and line[i] != ' ' and line[i] != '\t') ++i;
+				t.key = line.substr(start, i - start);
+				if (i < line.size() and line[i] == '=') {
+					++i;
+					t.has_value = true;
+					if (i < line.size() and line[i] == '"') {
+						t.quoted = true;
+						++i;
+						bool closed = false;
+						while (i < line.size()) {
+							char c = line[i++];
+							if (c == '"') { closed = true; break; }
+							if (c == '\\' and i < line.size()) {
+								c = line[i++];
+								c = c == 'n' ? '\n' : c == 't' ? '\t' : c;
+							}
+							t.value.push_back(c);
+						}
+						if (not closed) {
+							error = "unterminated string for " + std::string(t.key);
+							return false;
+						}
+					}
+					else {
+						const std::size_t vs = i;
+						while (i < line.size() and line[i] != ' ' and line[i] != '\t') ++i;
+						t.value.assign(line.substr(vs, i - vs));
+					}
+				}
+				if (t.key.empty()) {
+					error = "expected a key before '='";
+					return false;
+				}
+				tokens.push_back(std::move(t));
+			}
+			return true;
+		}
+
+		// "12", "12px" or "50%"
+		static bool parseLength(std::string_view s, ValueRec& out)
+		{
+			uint32_t unit = Px;
+			if (s.ends_with('%')) unit = Pct, s.remove_suffix(1);
+			else if (s.ends_with("px")) s.remove_suffix(2);
+			float v = 0.f;
+			if (not parseFloat(s, v)) return false;
+			out = { unit, v };
+			return true;
+		}
+
+		static bool parseFloat(std::string_view s, float& out)
+		{
+			if (s.empty()) return false;
+			// std::from_chars for float is not everywhere yet, strtof wants a terminated copy
+			char buf[64];
+			if (s.size() >= sizeof(buf)) return false;
+			std::memcpy(buf, s.data(), s.size());
+			buf[s.size()] = '\0';
+			char* end = nullptr;
+			out = std::strtof(buf, &end);
+			return end == buf + s.size();
+		}
+
+		static bool parseColor(std::string_view s, uint32_t& out)
+		{
+			if (not s.starts_with('#') or (s.size() != 7 and s.size() != 9)) return false;
+			uint32_t v = 0;
+			for (char c : s.substr(1)) {
+				uint32_t d;
+				if (c >= '0' and c <= '9') d = c - '0';
+				else if (c >= 'a' and c <= 'f') d = c - 'a' + 10;
+				else if (c >= 'A' and c <= 'F') d = c - 'A' + 10;
+				else return false;
+				v = v << 4 | d;
+			}
+			out = s.size() == 7 ? v << 8 | 0xff : v;
+			return true;
+		}
+
+		template <typename E, std::size_t N>
+		static bool parseEnum(std::string_view s, const std::pair<std::string_view, E> (&names)[N], uint8_t& out)
+		{
+			for (const auto& [name, e] : names)
+				if (s == name) {
+					out = static_cast<uint8_t>(e);
+					return true;
+				}
+			return false;
+		}
+
+		// true when key is a layout key; error is set when its value is bad
+		static bool styleKey(std::string_view key, std::string_view v, StyleRec& s, std::string& error)
+		{
+			using namespace Layout;
+			static constexpr std::pair<std::string_view, Direction> directions[] = { { "row", Direction::Row }, { "column", Direction::Column } };
+			static constexpr std::pair<std::string_view, Justify> justifies[] = {
+				{ "start", Justify::Start }, { "center", Justify::Center }, { "end", Justify::End },
+				{ "space-between", Justify::SpaceBetween }, { "space-around", Justify::SpaceAround }, { "space-evenly", Justify::SpaceEvenly } };
+			static constexpr std::pair<std::string_view, Align> aligns[] = {
+				{ "auto", Align::Auto }, { "start", Align::Start }, { "center", Align::Center }, { "end", Align::End }, { "stretch", Align::Stretch } };
+			static constexpr std::pair<std::string_view, Position> positions[] = { { "relative", Position::Relative }, { "absolute", Position::Absolute } };
+			static constexpr std::string_view sides[] = { "left", "top", "right", "bottom" };
+
+			bool ok = true;
+			auto length = [&](ValueRec& r) { ok = parseLength(v, r); };
+			auto number = [&](float& f) { ok = parseFloat(v, f); };
+			if (key == "dir" or key == "direction") ok = parseEnum(v, directions, s.direction);
+			else if (key == "justify") ok = parseEnum(v, justifies, s.justify);
+			else if (key == "align") ok = parseEnum(v, aligns, s.align_items);
+			else if (key == "self") ok = parseEnum(v, aligns, s.align_self);
+			else if (key == "position") ok = parseEnum(v, positions, s.position);
+			else if (key == "grow") number(s.grow);
+			else if (key == "shrink") number(s.shrink);
+			else if (key == "gap") number(s.gap);
+			else if (key == "basis") length(s.basis);
+			else if (key == "width") length(s.width);
+			else if (key == "height") length(s.height);
+			else if (key == "min-width") length(s.min_width);
+			else if (key == "min-height") length(s.min_height);
+			else if (key == "max-width") length(s.max_width);
+			else if (key == "max-height") length(s.max_height);
+			else if (key == "padding" or key == "margin") {
+				float f = 0.f;
+				number(f);
+				std::fill_n(key == "padding" ? s.padding : s.margin, 4, f);
+			}
+			else {
+				bool matched = false;
+				for (int i = 0; i < 4 and not matched; ++i) {
+					if (key.starts_with("padding-") and key.substr(8) == sides[i]) number(s.padding[i]), matched = true;
+					else if (key.starts_with("margin-") and key.substr(7) == sides[i]) number(s.margin[i]), matched = true;
+					else if (key == sides[i]) length(s.inset[i]), matched = true;
+				}
+				if (not matched) return false;
+			}
+			if (not ok) error = "bad value '" + std::string(v) + "' for " + std::string(key);
+			return true;
+		}
+
+		bool parseNode(std::string_view line, uint32_t parent, std::string& error)
+		{
+			tokens_.clear();
+			if (not tokenize(line, tokens_, error)) return false;
+			const Token& head = tokens_.front();
+			if (head.has_value) {
+				error = "a node starts with its type, got " + std::string(head.key) + "=";
+				return false;
+			}
+
+			NodeRec n{};
+			n.parent = parent;
+			n.first_attr = static_cast<uint32_t>(attrs_.size());
+			n.style.align_items = static_cast<uint8_t>(Layout::Align::Stretch);
+			n.style.shrink = 1.f;
+			if (head.key == "row") n.style.direction = static_cast<uint8_t>(Layout::Direction::Row);
+
+			auto [type_it, added] = type_index_.try_emplace(std::string(head.key), static_cast<uint32_t>(types_.size()));
+			if (added) types_.push_back({ intern(head.key), 0 });
+			n.type = type_it->second;
+			n.type_slot = types_[n.type].count++;
+
+			for (std::size_t i = 1; i < tokens_.size(); ++i) {
+				const Token& t = tokens_[i];
+				if (not t.has_value) {
+					if (t.key == "hidden") n.flags |= NodeHidden;
+					else attrs_.push_back({ intern(t.key), AttrKind::Bool, 1, intern("true") });
+					continue;
+				}
+				if (t.key == "name") {
+					n.name = intern(t.value);
+					continue;
+				}
+				if (t.key == "hidden") {
+					if (t.value != "true" and t.value != "false") {
+						error = "bad value '" + t.value + "' for hidden";
+						return false;
+					}
+					if (t.value == "true") n.flags |= NodeHidden;
+					continue;
+				}
+				if (not t.quoted and styleKey(t.key, t.value, n.style, error)) {
+					if (not error.empty()) return false;
+					continue;
+				}
+				AttrRec a{ intern(t.key), AttrKind::String, 0, intern(t.value) };
+				float f = 0.f;
+				if (t.quoted) a.bits = a.text;
+				else if (t.value == "true" or t.value == "false") a.kind = AttrKind::Bool, a.bits = t.value == "true";
+				else if (parseColor(t.value, a.bits)) a.kind = AttrKind::Color;
+				else if (parseFloat(t.value, f)) a.kind = AttrKind::Number, a.bits = std::bit_cast<uint32_t>(f);
+				else a.bits = a.text;
+				attrs_.push_back(a);
+			}
+			const std::size_t count = attrs_.size() - n.first_attr;
+			if (count > UINT16_MAX) {
+				error = "too many attributes";
+				return false;
+			}
+			n.attr_count = static_cast<uint16_t>(count);
+			nodes_.push_back(n);
+			return true;
+		}
+
+		void emit(std::vector<std::byte>& out) const
+		{
+			auto align4 = [](std::size_t v) { return (v + 3) & ~std::size_t(3); };
+			Header h{};
+			std::memcpy(h.magic, Magic, 4);
+			h.version = Version;
+			h.node_count = static_cast<uint32_t>(nodes_.size());
+			h.attr_count = static_cast<uint32_t>(attrs_.size());
+			h.type_count = static_cast<uint32_t>(types_.size());
+			std::size_t at = sizeof(Header);
+			h.nodes_offset = static_cast<uint32_t>(at);
+			at += nodes_.size() * sizeof(NodeRec);
+			h.attrs_offset = static_cast<uint32_t>(at);
+			at += attrs_.size() * sizeof(AttrRec);
+			h.types_offset = static_cast<uint32_t>(at);
+			at += types_.size() * sizeof(TypeRec);
+			h.strings_offset = static_cast<uint32_t>(at);
+			h.strings_size = static_cast<uint32_t>(strings_.size());
+			h.total_size = static_cast<uint32_t>(align4(at + strings_.size()));
+
+			out.assign(h.total_size, std::byte{ 0 });
+			std::memcpy(out.data(), &h, sizeof(h));
+			std::memcpy(out.data() + h.nodes_offset, nodes_.data(), nodes_.size() * sizeof(NodeRec));
+			std::memcpy(out.data() + h.attrs_offset, attrs_.data(), attrs_.size() * sizeof(AttrRec));
+			std::memcpy(out.data() + h.types_offset, types_.data(), types_.size() * sizeof(TypeRec));
+			std::memcpy(out.data() + h.strings_offset, strings_.data(), strings_.size());
+		}
+
+		std::vector<NodeRec> nodes_;
+		std::vector<AttrRec> attrs_;
+		std::vector<TypeRec> types_;
+		std::string strings_;
+		std::unordered_map<std::string, uint32_t> string_index_, type_index_;
+		std::vector<Token> tokens_;
+		std::string error_;
+	};
+
+	// Read-only mapping of a whole file, empty when it can't be opened or
+	// mapped (eg. Android assets), the caller then reads it instead.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& path) { open(path); }
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+		MappedFile& operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other) {
+				close();
+				std::swap(data_, other.data_);
+				std::swap(size_, other.size_);
+			}
+			return *this;
+		}
+		~MappedFile() { close(); }
+
+		bool open(const std::string& path)
+		{
+			close();
+#ifdef _WIN32
+			HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) return false;
+			LARGE_INTEGER size{};
+			if (GetFileSizeEx(file, &size) and size.QuadPart > 0) {
+				if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+					data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+					CloseHandle(mapping);
+					if (data_) size_ = static_cast<std::size_t>(size.QuadPart);
+				}
+			}
+			CloseHandle(file);
+#else
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0) return false;
+			struct stat st{};
+			if (fstat(fd, &st) == 0 and st.st_size > 0) {
+				void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (p != MAP_FAILED) data_ = p, size_ = static_cast<std::size_t>(st.st_size);
+			}
+			::close(fd);
+#endif
+			return data_ != nullptr;
+		}
+
+		void close()
+		{
+			if (data_ == nullptr) return;
+#ifdef _WIN32
+			UnmapViewOfFile(data_);
+#else
+			munmap(data_, size_);
+#endif
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+		const void* data() const { return data_; }
+		std::size_t size() const { return size_; }
+
+	private:
+		void* data_ = nullptr;
+		std::size_t size_ = 0;
+	};
+
+} // namespace UiBlob
+
+#ifdef VOLT_UIC_MAIN
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+int main(int argc, char** argv)
+{
+	if (argc != 3) {
+		std::fprintf(stderr, "usage: %s <screen.vui> <screen.vuib>\n", argv[0]);
+		return 2;
+	}
+	std::ifstream in(argv[1], std::ios::binary);
+	if (not in) {
+		std::fprintf(stderr, "cannot read %s\n", argv[1]);
+		return 1;
+	}
+	std::stringstream source;
+	source << in.rdbuf();
+	std::vector<std::byte> blob;
+	std::string error;
+	if (not UiBlob::Compiler{}.compile(source.str(), blob, &error)) {
+		std::fprintf(stderr, "%s:%s\n", argv[1], error.c_str());
+		return 1;
+	}
+	std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+	out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+	if (not out) {
+		std::fprintf(stderr, "cannot write %s\n", argv[2]);
+		return 1;
+	}
+	return 0;
+}
+#endif // VOLT_UIC_MAIN
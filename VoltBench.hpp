@@ -0,0 +1,446 @@
+#pragma once
+// VoltBench.hpp -- headless widget benchmarks with a JSON report.
+//
+// Runs an Application with Config::headless (offscreen video driver, software
+// renderer) so it works on CI machines without a display or GPU. One scene
+// per run, built from a size parameter and driven by scripted input:
+//
+//	textareas  N TextAreas laid out in a grid, static redraw
+//	cellblock  CellBlock with N cells, repeated fling scrolls
+//	schemablock  the cellblock scene with typed SchemaCell rows
+//	plotter    Plotter with N points of a moving sine
+//	editbox    EditBox holding N characters, typing and cursor keys
+//	uiscreen   settings screen of N widgets instantiated from a compiled UI
+//	           description, build_ms in the report is the instantiate() time
+//
+// Per frame it reports UI thread CPU time, wall time, heap allocations and
+// SDL draw calls. The idle and scrolling scenes (all but plotter and editbox,
+// which produce new content every frame) must not touch the heap once warmed
+// up: a steady frame with FrameArena::lastFrameHeapAllocs() != 0 is counted
+// in steady_alloc_frames and fails the run. Frames around a press, a release
+// or a cell being filled aren't steady. Build it from a single translation unit, which must include
+// this header before anything else includes volt.h so the draw-call counting
+// macros are seen by the library:
+//
+//	// volt_bench.cpp
+//	#define VOLT_BENCH_MAIN
+//	#include "VoltBench.hpp"
+//
+//	./volt_bench --scene cellblock --count 2000 --frames 600 --out cellblock.json
+//
+// --step-ms 16.6 puts Volt::Clock in virtual mode and advances it by that much
+// per frame, so animations run at a fixed simulated rate however fast the
+// frames go and runs become repeatable.
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace VoltBench {
+
+	// heap allocations are counted by Volt::HeapCounter, see FrameArena.hpp
+	struct Counters {
+		std::atomic<uint64_t> draw_calls{ 0 };
+	};
+
+	inline Counters& counters()
+	{
+		static Counters c;
+		return c;
+	}
+
+	inline void countDraw()
+	{
+		counters().draw_calls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// CPU time of the calling thread, so worker threads don't blur the UI thread numbers
+	inline double threadCpuMs()
+	{
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+		timespec ts{};
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+		return static_cast<double>(ts.tv_sec) * 1e3 + static_cast<double>(ts.tv_nsec) / 1e6;
+#else
+		return static_cast<double>(std::clock()) * 1e3 / CLOCKS_PER_SEC;
+#endif
+	}
+
+} // namespace VoltBench
+
+// every draw volt issues goes through one of these, the macros only add a counter
+#define SDL_RenderTexture(...) (VoltBench::countDraw(), SDL_RenderTexture(__VA_ARGS__))
+#define SDL_RenderTextureRotated(...) (VoltBench::countDraw(), SDL_RenderTextureRotated(__VA_ARGS__))
+#define SDL_RenderFillRect(...) (VoltBench::countDraw(), SDL_RenderFillRect(__VA_ARGS__))
+#define SDL_RenderFillRects(...) (VoltBench::countDraw(), SDL_RenderFillRects(__VA_ARGS__))
+#define SDL_RenderRect(...) (VoltBench::countDraw(), SDL_RenderRect(__VA_ARGS__))
+#define SDL_RenderLine(...) (VoltBench::countDraw(), SDL_RenderLine(__VA_ARGS__))
+#define SDL_RenderPoint(...) (VoltBench::countDraw(), SDL_RenderPoint(__VA_ARGS__))
+#define SDL_RenderPoints(...) (VoltBench::countDraw(), SDL_RenderPoints(__VA_ARGS__))
+#define SDL_RenderGeometry(...) (VoltBench::countDraw(), SDL_RenderGeometry(__VA_ARGS__))
+
+#ifdef VOLT_BENCH_MAIN
+#define VOLT_COUNT_ALLOCATIONS
+#endif
+#include "volt.h"
+
+namespace VoltBench {
+
+	struct Options {
+		std::string scene = "textareas";
+		int count = 100;
+		int frames = 300;
+		int warmup = 30;   // frames run before measuring, caches and atlases fill here
+		double step_ms = 0.0; // > 0 runs animations on virtual time, advanced by this much per frame
+		std::string out;   // stdout when empty
+	};
+
+	struct Frame {
+		double cpu_ms = 0.0;
+		double wall_ms = 0.0;
+		uint64_t allocs = 0;
+		uint64_t alloc_bytes = 0;
+		uint64_t draw_calls = 0;
+	};
+
+	class BenchApp : public Application {
+	public:
+		explicit BenchApp(const Options& opts) : opts_(opts) {}
+
+		bool build()
+		{
+			const float W = bounds.w, H = bounds.h;
+			if (opts_.scene == "textareas") {
+				const int cols = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(opts_.count))));
+				const int rows = (opts_.count + cols - 1) / cols;
+				text_areas_.resize(opts_.count);
+				for (int i = 0; i < opts_.count; ++i) {
+					TextArea::Attributes a;
+					a.text = "TextArea " + std::to_string(i);
+					a.bounds = { (i % cols) * W / cols, (i / cols) * H / rows, W / cols, H / rows };
+					text_areas_[i].Build(this, a);
+					tree_.addView("ta" + std::to_string(i), &text_areas_[i]);
+				}
+			}
+			else if (opts_.scene == "cellblock") {
+				CellBlockProps props;
+				props.rect = { 0.f, 0.f, W, H };
+				const float cell_h = H / 12.f;
+				cell_block_.setOnFillNewCellData([this, cell_h](Cell& cell) {
+					++disturbances_;
+					cell_block_.setCellRect(cell, 1, cell_h);
+					TextArea::Attributes a;
+					a.text = "Cell " + std::to_string(cell.index);
+					a.bounds = { 5.f, 10.f, 90.f, 80.f };
+					cell.addTextArea(a);
+					});
+				cell_block_.Build(this, opts_.count, 1, props);
+				tree_.addView("cellblock", &cell_block_);
+			}
+			else if (opts_.scene == "schemablock") {
+				CellBlockProps props;
+				props.rect = { 0.f, 0.f, W, H };
+				const float cell_h = H / 12.f;
+				schema_block_.setOnFillNewCellData([this, cell_h](LabelRow& row) {
+					++disturbances_;
+					schema_block_.setCellRect(row, 1, cell_h);
+					TextArea::Attributes a;
+					a.text = "Cell " + std::to_string(row.index);
+					a.bounds = row.cellRect({ 5.f, 10.f, 90.f, 80.f });
+					row.get<TextArea>().Build(&row, a);
+					});
+				schema_block_.Build(this, opts_.count, 1, props);
+				tree_.addView("schemablock", &schema_block_);
+			}
+			else if (opts_.scene == "plotter") {
+				PlotterAttributes a;
+				a.rect = { 0.f, 0.f, W, H };
+				plotter_.Build(this, a);
+				plotter_.setViewPort(0.0, static_cast<double>(opts_.count), -1.2, 1.2);
+				tree_.addView("plotter", &plotter_);
+			}
+			else if (opts_.scene == "editbox") {
+				EditBoxAttributes a;
+				a.rect = { W * 0.05f, H * 0.05f, W * 0.9f, H * 0.9f };
+				a.maxlines = 0;
+				std::string text;
+				text.reserve(opts_.count);
+				static constexpr const char* lorem = "lorem ipsum dolor sit amet consectetur adipiscing elit ";
+				while (static_cast<int>(text.size()) < opts_.count)
+					text += lorem;
+				text.resize(opts_.count);
+				a.textAttributes = TextAttributes(text, { 0, 0, 0, 255 }, { 255, 255, 255, 255 });
+				edit_box_.Build(this, a);
+				tree_.addView("editbox", &edit_box_);
+			}
+			else if (opts_.scene == "uiscreen") {
+				// label + toggle or slider per row, every eighth row starts a hidden section
+				std::string src = "column name=root padding=8 gap=4\n";
+				for (int i = 0; i < opts_.count; i += 2) {
+					const std::string n = std::to_string(i);
+					if (i % 16 == 8)
+						src += "  column name=section" + n + " hidden\n";
+					const char* indent = i % 16 >= 8 ? "    " : "  ";
+					src += std::string(indent) + "row height=28 gap=8 align=center\n";
+					src += std::string(indent) + "  text name=label" + n + " text=\"Setting " + n + "\" grow=1 font-size=14\n";
+					src += std::string(indent) + (i % 4 ? "  slider width=120 height=16 max=100 value=50" : "  toggle width=48 height=24") + " name=w" + n + "\n";
+				}
+				if (not screen_.loadSource(src))
+					return false;
+				screen_.instantiate(this, { 0.f, 0.f, W, H });
+				build_ms_ = static_cast<double>(screen_.buildTimeNs()) / 1e6;
+			}
+			else {
+				GLogger.Log(Logger::Level::Error, "VoltBench: unknown scene", opts_.scene);
+				return false;
+			}
+			// no frame cap, every frame is measured back to back
+			FramePacer::Get().setTargetFps(100000.f);
+			// growing it mid run would be counted against the frame
+			frames_.reserve(opts_.frames + 1);
+			if (opts_.step_ms > 0.0)
+				Volt::Clock::Get().setVirtual(true);
+			return true;
+		}
+
+		bool handleEvent() override
+		{
+			return views().handleEvent();
+		}
+
+		void onUpdate() override
+		{
+			sample();
+			script(frame_);
+			if (opts_.scene == "plotter")
+				plot(frame_);
+			views().onUpdate();
+			if (opts_.step_ms > 0.0)
+				Volt::Clock::Get().advance(static_cast<uint64_t>(opts_.step_ms * 1e6));
+			++frame_;
+			if (frame_ >= opts_.warmup + opts_.frames + 1)
+				quit = true;
+			// keep the loop busy, it would otherwise sleep until the next event
+			WakeGui();
+		}
+
+		void draw() override
+		{
+			SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+			SDL_RenderClear(renderer);
+			views().draw();
+		}
+
+		bool writeReport() const
+		{
+			std::ofstream file;
+			if (not opts_.out.empty()) {
+				file.open(opts_.out, std::ios::out | std::ios::trunc);
+				if (not file.is_open()) {
+					GLogger.Log(Logger::Level::Error, "VoltBench: failed to open", opts_.out);
+					return false;
+				}
+			}
+			std::ostream& out = opts_.out.empty() ? std::cout : file;
+			std::vector<double> cpu;
+			cpu.reserve(frames_.size());
+			for (const auto& f : frames_) cpu.push_back(f.cpu_ms);
+			std::sort(cpu.begin(), cpu.end());
+			auto pct = [&cpu](double q) {
+				return cpu.empty() ? 0.0 : cpu[std::min(cpu.size() - 1, static_cast<size_t>(q * (cpu.size() - 1) + 0.5))];
+			};
+
+			out << std::fixed << std::setprecision(4);
+			out << "{\"scene\":\"" << opts_.scene << "\",\"count\":" << opts_.count
+				<< ",\"frames\":" << frames_.size()
+				<< ",\"renderer\":\"" << (renderer ? SDL_GetRendererName(renderer) : "none") << "\""
+				<< ",\"build_ms\":" << build_ms_
+				<< ",\"steady_alloc_frames\":" << steady_alloc_frames_
+				<< ",\"cpu_ms\":{\"p50\":" << pct(0.5) << ",\"p95\":" << pct(0.95) << ",\"p99\":" << pct(0.99)
+				<< ",\"max\":" << (cpu.empty() ? 0.0 : cpu.back()) << "}"
+				<< ",\"per_frame\":[";
+			for (size_t i = 0; i < frames_.size(); ++i) {
+				const auto& f = frames_[i];
+				out << (i ? "," : "") << "\n{\"cpu_ms\":" << f.cpu_ms << ",\"wall_ms\":" << f.wall_ms
+					<< ",\"allocs\":" << f.allocs << ",\"alloc_bytes\":" << f.alloc_bytes
+					<< ",\"draw_calls\":" << f.draw_calls << "}";
+			}
+			out << "\n]}\n";
+			return out.good();
+		}
+
+		// steady frames that allocated, see the top of this file
+		int steadyAllocFrames() const { return steady_alloc_frames_; }
+		int firstSteadyAllocFrame() const { return first_steady_alloc_frame_; }
+
+	private:
+		ViewTree& views()
+		{
+			return opts_.scene == "uiscreen" ? screen_.views() : tree_;
+		}
+
+		// closes the previous frame: everything between two onUpdate calls,
+		// events, draw and present included
+		void sample()
+		{
+			auto& c = counters();
+			const double cpu = threadCpuMs();
+			const Uint64 wall = SDL_GetTicksNS();
+			const uint64_t allocs = Volt::HeapCounter::allocs().load(std::memory_order_relaxed);
+			const uint64_t bytes = Volt::HeapCounter::bytes().load(std::memory_order_relaxed);
+			const uint64_t draws = c.draw_calls.load(std::memory_order_relaxed);
+			if (frame_ > opts_.warmup) {
+				frames_.push_back({ cpu - last_.cpu_ms, static_cast<double>(wall - last_wall_) / 1e6,
+					allocs - last_.allocs, bytes - last_.alloc_bytes, draws - last_.draw_calls });
+				checkSteadyFrame();
+			}
+			last_ = { cpu, 0.0, allocs, bytes, draws };
+			last_wall_ = wall;
+		}
+
+		// The arena counts from one present to the next while sample() runs
+		// mid frame, so a frame is steady once two samples in a row saw no
+		// press, release or cell fill.
+		void checkSteadyFrame()
+		{
+			quiet_samples_ = disturbances_ == last_disturbances_ ? quiet_samples_ + 1 : 0;
+			last_disturbances_ = disturbances_;
+			if (opts_.scene == "plotter" or opts_.scene == "editbox" or quiet_samples_ < 2)
+				return;
+			// logged after the run, logging here would allocate into the next frame
+			if (Volt::FrameArena::Get().lastFrameHeapAllocs() != 0 and steady_alloc_frames_++ == 0)
+				first_steady_alloc_frame_ = frame_ - 1;
+		}
+
+		void pushFinger(Uint32 type, float x, float y, float dx, float dy)
+		{
+			if (type != SDL_EVENT_FINGER_MOTION)
+				++disturbances_;
+			SDL_Event ev;
+			SDL_zero(ev);
+			ev.type = type;
+			ev.tfinger.timestamp = SDL_GetTicksNS();
+			ev.tfinger.touchID = 1;
+			ev.tfinger.fingerID = 1;
+			ev.tfinger.x = x, ev.tfinger.y = y;
+			ev.tfinger.dx = dx, ev.tfinger.dy = dy;
+			SDL_PushEvent(&ev);
+		}
+
+		void script(int frame)
+		{
+			if (opts_.scene == "cellblock" or opts_.scene == "schemablock") {
+				// a 20 frame swipe every 60 frames, alternating direction
+				const int phase = frame % 60;
+				const float dir = (frame / 60) % 2 ? 1.f : -1.f;
+				const float y0 = dir < 0.f ? 0.8f : 0.2f;
+				const float step = 0.03f * dir;
+				if (phase == 0)
+					pushFinger(SDL_EVENT_FINGER_DOWN, 0.5f, y0, 0.f, 0.f);
+				else if (phase < 20)
+					pushFinger(SDL_EVENT_FINGER_MOTION, 0.5f, y0 + step * phase, 0.f, step);
+				else if (phase == 20)
+					pushFinger(SDL_EVENT_FINGER_UP, 0.5f, y0 + step * 20, 0.f, 0.f);
+			}
+			else if (opts_.scene == "editbox") {
+				if (frame == 0) {
+					// focus
+					pushFinger(SDL_EVENT_FINGER_DOWN, 0.5f, 0.5f, 0.f, 0.f);
+					pushFinger(SDL_EVENT_FINGER_UP, 0.5f, 0.5f, 0.f, 0.f);
+					return;
+				}
+				SDL_Event ev;
+				SDL_zero(ev);
+				ev.common.timestamp = SDL_GetTicksNS();
+				if (frame % 10 == 0) {
+					ev.type = SDL_EVENT_KEY_DOWN;
+					ev.key.scancode = (frame / 10) % 2 ? SDL_SCANCODE_LEFT : SDL_SCANCODE_RIGHT;
+					ev.key.down = true;
+				}
+				else {
+					ev.type = SDL_EVENT_TEXT_INPUT;
+					ev.text.text = "a";
+				}
+				SDL_PushEvent(&ev);
+			}
+		}
+
+		void plot(int frame)
+		{
+			const double phase = frame * 0.05;
+			for (int i = 1; i < opts_.count; ++i)
+				plotter_.drawLine(i - 1, std::sin((i - 1) * 0.05 + phase), i, std::sin(i * 0.05 + phase), { 80, 200, 120, 255 });
+		}
+
+		Options opts_;
+		ViewTree tree_;
+		std::vector<TextArea> text_areas_;
+		CellBlock cell_block_;
+		using LabelRow = SchemaCell<CellSlot<TextArea>>;
+		BasicCellBlock<LabelRow> schema_block_;
+		Plotter plotter_;
+		EditBox edit_box_;
+		UiScreen screen_;
+		double build_ms_ = 0.0;
+		std::vector<Frame> frames_;
+		int steady_alloc_frames_ = 0, first_steady_alloc_frame_ = -1;
+		uint64_t disturbances_ = 0, last_disturbances_ = 0;
+		int quiet_samples_ = 0;
+		Frame last_;
+		Uint64 last_wall_ = 0;
+		int frame_ = 0;
+	};
+
+	inline Options parseArgs(int argc, char** argv)
+	{
+		Options o;
+		for (int i = 1; i + 1 < argc; i += 2) {
+			const std::string key = argv[i], val = argv[i + 1];
+			if (key == "--scene") o.scene = val;
+			else if (key == "--count") o.count = std::max(1, std::atoi(val.c_str()));
+			else if (key == "--frames") o.frames = std::max(1, std::atoi(val.c_str()));
+			else if (key == "--warmup") o.warmup = std::max(0, std::atoi(val.c_str()));
+			else if (key == "--step-ms") o.step_ms = std::max(0.0, std::atof(val.c_str()));
+			else if (key == "--out") o.out = val;
+		}
+		return o;
+	}
+
+	inline int run(int argc, char** argv)
+	{
+		const Options opts = parseArgs(argc, argv);
+		BenchApp app(opts);
+		Application::Config cfg;
+		cfg.title = "volt_bench";
+		cfg.headless = true;
+		cfg.init_img = false;
+		cfg.pw = 50, cfg.ph = 50;
+		if (not app.create(cfg) or not app.build())
+			return 1;
+		app.run();
+		const bool written = app.writeReport();
+		if (app.steadyAllocFrames() != 0)
+			GLogger.Log(Logger::Level::Error, "VoltBench: steady frames allocated:", app.steadyAllocFrames(),
+						"first at frame", app.firstSteadyAllocFrame());
+		return written and app.steadyAllocFrames() == 0 ? 0 : 1;
+	}
+
+} // namespace VoltBench
+
+#ifdef VOLT_BENCH_MAIN
+
+int main(int argc, char** argv)
+{
+	return VoltBench::run(argc, argv);
+}
+
+#endif // VOLT_BENCH_MAIN
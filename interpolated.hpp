@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include "Clock.hpp"
 
 /// The currently supported transition functions
 enum class TransitionFunction
@@ -152,15 +153,10 @@ struct Interpolated
 	{
 	}
 
-	/// Returns stop watch time (should be better compared to UTC timestamps for float precision)
+	/// Returns the frame time of Volt::Clock in seconds (counted from app start, so float keeps its precision)
 	[[nodiscard]] static float getCurrentTime()
 	{
-		// Retrieve current time
-		auto const now = std::chrono::steady_clock::now();
-		auto const duration = now.time_since_epoch();
-		// Convert it to a decimal number of seconds
-		auto const seconds = std::chrono::duration_cast<std::chrono::duration<float>>(duration);
-		return seconds.count();
+		return static_cast<float>(Volt::Clock::Get().nowSeconds());
 	}
 
 	/// Returns the number of seconds since the last value change
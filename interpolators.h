@@ -3,15 +3,15 @@
 #include <cmath>     // For std::pow, std::sqrt, std::fabs, std::min, std::max, std::clamp
 #include <cstdint>   // For uint32_t
 #include <algorithm> // For std::min, std::max, std::clamp
+#include "Clock.hpp"  // Volt::Clock, the per-frame animation clock
 
 // Define M_PI if it's not available (e.g., on some compilers without _USE_MATH_DEFINES)
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-// CRITICAL ASSUMPTION: SDL_GetTicks() must be available.
-// If not using SDL, replace SDL_GetTicks() with your system's millisecond timer.
-// Example: #include <SDL.h> // Usually included in your project's PCH or relevant .cpp files
+// Time is read from Volt::Clock, sampled once per frame, so every interpolator
+// in a frame sees the same timestamp and virtual time can step them.
 
 // --- Base Interpolator ---
 
@@ -33,7 +33,7 @@ public:
      */
     virtual void start(uint32_t durationMillis) {
         m_durationMillis = durationMillis > 0 ? durationMillis : 1u; // Avoid division by zero
-        m_startTimeMillis = SDL_GetTicks(); // Assumes SDL_GetTicks() is accessible
+        m_startTimeMillis = static_cast<uint32_t>(Volt::Clock::Get().nowMs());
         m_isRunning = true;
         m_isFinished = false;
     }
@@ -65,7 +65,7 @@ public:
             return m_isFinished ? ease(1.0f) : ease(0.0f);
         }
 
-        uint32_t currentTimeMillis = SDL_GetTicks();
+        uint32_t currentTimeMillis = static_cast<uint32_t>(Volt::Clock::Get().nowMs());
         uint32_t elapsedTimeMillis = currentTimeMillis - m_startTimeMillis;
 
         if (elapsedTimeMillis >= m_durationMillis) {
@@ -88,7 +88,7 @@ public:
         if (m_isFinished) return ease(1.0f); // Finished at target
 
         // If running, calculate current factor
-        uint32_t currentTimeMillis = SDL_GetTicks();
+        uint32_t currentTimeMillis = static_cast<uint32_t>(Volt::Clock::Get().nowMs());
         uint32_t elapsedTimeMillis = currentTimeMillis - m_startTimeMillis;
 
         if (elapsedTimeMillis >= m_durationMillis) {
@@ -112,7 +112,7 @@ public:
         if (m_isFinished) return true;
         if (!m_isRunning) return false; // Not running and not marked finished.
         
-        uint32_t currentTimeMillis = SDL_GetTicks();
+        uint32_t currentTimeMillis = static_cast<uint32_t>(Volt::Clock::Get().nowMs());
         return (currentTimeMillis - m_startTimeMillis) >= m_durationMillis;
     }
 
@@ -392,7 +392,7 @@ public:
         }
         // getFactor() will update isRunning and isFinished, so call it to sync state.
         // However, we need the raw time for calculation here.
-        uint32_t currentTimeMillis = SDL_GetTicks();
+        uint32_t currentTimeMillis = static_cast<uint32_t>(Volt::Clock::Get().nowMs());
         uint32_t elapsedTimeMillis = currentTimeMillis - m_startTimeMillis;
         float tSeconds = static_cast<float>(elapsedTimeMillis) / 1000.0f;
         
@@ -11,6 +11,8 @@
 
 #include <iostream>
 #include <string_view>
+#include <charconv>
+#include <cstring>
 #include <cmath>
 #include <vector>
 #include <array>
@@ -45,6 +47,14 @@
 // #include <arm_neon.h> // For NEON intrinsics
 
 #include "volt_util.h"
+#include "PCQueue.hpp"
+#include "SpatialGridCore.hpp"
+#include "LayoutCore.hpp"
+#include "UiBlobCore.hpp"
+#include "GestureCore.hpp"
+#include "SettingsStore.hpp"
+#include "StringId.hpp"
+#include "Function.hpp"
 #include "volt_fonts.h"
 //#include "mp.h"
 #include "interpolators.h"
@@ -153,45 +163,225 @@ static int SDLCALL myEventFilter(void *userdata, SDL_Event *event)
 #endif
 }
 
+// the one user event type used to wake the gui thread, registered on first use
+inline Uint32 WakeEventType()
+{
+	static const Uint32 type = SDL_RegisterEvents(1);
+	return type;
+}
+
 inline void WakeGui()
 {
-	SDL_Event RedrawTriggeredEvent;
-	RedrawTriggeredEvent.type = SDL_RegisterEvents(1);
+	SDL_Event RedrawTriggeredEvent{};
+	RedrawTriggeredEvent.type = WakeEventType();
 	SDL_PushEvent(&RedrawTriggeredEvent);
 }
 
-std::mutex AdaptiveVsyncMux;
+/*
+	Runs callables on the gui thread. Any thread may post; the gui loop drains
+	the queue once per frame within a time budget. Only the post that makes
+	the queue non-empty pushes a wake event, so a flood of results from the
+	workers costs one SDL event.
+	*/
+class UiTaskQueue
+{
+public:
+	static UiTaskQueue &Get()
+	{
+		static UiTaskQueue instance;
+		return instance;
+	}
+
+	UiTaskQueue(const UiTaskQueue &) = delete;
+	UiTaskQueue(UiTaskQueue &&) = delete;
+
+	void post(std::function<void()> _task)
+	{
+		tasks_.enqueue(std::move(_task));
+		if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+			WakeGui();
+	}
+
+	// gui thread only. Stops once _budget_ns is used up and wakes the next
+	// frame itself when work is left over.
+	size_t drain(Uint64 _budget_ns)
+	{
+		if (pending_.load(std::memory_order_acquire) == 0)
+			return 0;
+		const Uint64 start = SDL_GetTicksNS();
+		size_t ran = 0;
+		std::function<void()> task;
+		while (tasks_.dequeue(task))
+		{
+			if (task)
+				task();
+			task = nullptr;
+			++ran;
+			pending_.fetch_sub(1, std::memory_order_acq_rel);
+			if (SDL_GetTicksNS() - start >= _budget_ns)
+				break;
+		}
+		// over budget, or a producer hadn't finished publishing its task yet
+		if (pending_.load(std::memory_order_acquire) != 0)
+			WakeGui();
+		return ran;
+	}
+
+	size_t pending() const
+	{
+		return pending_.load(std::memory_order_relaxed);
+	}
+
+	UiTaskQueue &setFrameBudgetMs(float _ms)
+	{
+		budget_ns_ = static_cast<Uint64>(std::max(0.f, _ms) * 1e6f);
+		return *this;
+	}
+
+	Uint64 frameBudgetNs() const
+	{
+		return budget_ns_;
+	}
+
+private:
+	UiTaskQueue() = default;
+
+	MPSCQueue<std::function<void()>> tasks_;
+	std::atomic<size_t> pending_{0};
+	Uint64 budget_ns_ = 4000000; // 4ms
+};
+
+// queue _task to run on the gui thread, safe from any thread
+template <typename F>
+inline void postToUi(F &&_task)
+{
+	UiTaskQueue::Get().post(std::function<void()>(std::forward<F>(_task)));
+}
 
 class AdaptiveVsyncHandler;
 
+/*
+	Decides how the gui thread waits for the next frame: not at all while any
+	redraw session is open, until a requested deadline (requestFrameAt/After),
+	or until the next event. Sessions and deadlines are plain atomics, so any
+	thread may open them without locking.
+	*/
 class AdaptiveVsync
 {
 public:
 	friend class AdaptiveVsyncHandler;
+	static constexpr Uint64 NoDeadline = UINT64_MAX;
+
+	AdaptiveVsync() = default;
 
-	auto pollEvent(SDL_Event *_event) const -> int
+	AdaptiveVsync(const AdaptiveVsync &_other)
 	{
-		if (no_sleep_requests)
+		*this = _other;
+	}
+
+	AdaptiveVsync &operator=(const AdaptiveVsync &_other)
+	{
+		no_sleep_requests.store(_other.no_sleep_requests.load());
+		next_deadline_ns.store(_other.next_deadline_ns.load());
+		parent = _other.parent;
+		return *this;
+	}
+
+	// _max_wait_ms bounds the wait further (eg. the next UI timer), -1 for no bound
+	auto pollEvent(SDL_Event *_event, Sint32 _max_wait_ms = -1) -> int
+	{
+		if (no_sleep_requests.load())
 			return SDL_PollEvent(_event);
+
+		// announce the wait before reading the deadline, requesters that lower
+		// the deadline after this point see waiting == true and wake us up
+		waiting.store(true);
+		const Uint64 deadline = next_deadline_ns.load();
+		Sint32 timeout = _max_wait_ms;
+		if (deadline != NoDeadline)
+		{
+			const Uint64 now = SDL_GetTicksNS();
+			const Sint32 until_deadline = deadline > now ? static_cast<Sint32>((deadline - now + 999999) / 1000000) : 0;
+			timeout = timeout < 0 ? until_deadline : std::min(timeout, until_deadline);
+		}
+		int res = 0;
+		if (timeout < 0)
+			res = SDL_WaitEvent(_event);
+		else if (timeout > 0)
+			res = SDL_WaitEventTimeout(_event, timeout);
 		else
-			return SDL_WaitEvent(_event);
+			res = SDL_PollEvent(_event);
+		waiting.store(false);
+		consumeDueDeadline(SDL_GetTicksNS());
+		return res;
 	}
 
 	auto hasRequests()const
 	{
-		if (!no_sleep_requests)
+		if (!no_sleep_requests.load())
 			return false;
 		return true;
 	}
 
+	// Ask for one frame to be drawn at or after _ticks_ns (SDL_GetTicksNS clock).
+	// Safe from any thread. Deadlines are one-shot and only the earliest pending
+	// one is kept, periodic animations re-arm from onUpdate.
+	void requestFrameAt(Uint64 _ticks_ns)
+	{
+		if (nullptr != parent)
+		{
+			parent->requestFrameAt(_ticks_ns);
+			return;
+		}
+		Uint64 cur = next_deadline_ns.load();
+		while (_ticks_ns < cur)
+		{
+			if (next_deadline_ns.compare_exchange_weak(cur, _ticks_ns))
+			{
+				if (waiting.load())
+					WakeGui();
+				return;
+			}
+		}
+	}
+
+	void requestFrameAfter(Uint32 _ms)
+	{
+		requestFrameAt(SDL_GetTicksNS() + static_cast<Uint64>(_ms) * 1000000ull);
+	}
+
+	Uint64 nextDeadline() const
+	{
+		return nullptr != parent ? parent->nextDeadline() : next_deadline_ns.load();
+	}
+
+	// nested vsyncs (eg. CellBlock's) forward their deadlines to the one the
+	// application actually waits on
+	void setParent(AdaptiveVsync *_parent)
+	{
+		parent = _parent == this ? nullptr : _parent;
+	}
+
 private:
-	std::uint32_t no_sleep_requests = 0;
+	void consumeDueDeadline(Uint64 _now)
+	{
+		Uint64 cur = next_deadline_ns.load();
+		while (cur <= _now and not next_deadline_ns.compare_exchange_weak(cur, NoDeadline))
+		{
+		}
+	}
+
+	std::atomic<std::uint32_t> no_sleep_requests{0};
+	std::atomic<Uint64> next_deadline_ns{NoDeadline};
+	std::atomic<bool> waiting{false};
+	AdaptiveVsync *parent = nullptr;
 };
 
 /*
 	Volt uses a event driven sys and only draws upon request("only when necessary").
 	if you have an object/drawable that needs the drawing thread to stay alive eg animation, you must use this class to
-	tell volt when not to hybernate the drawing thread
+	tell volt when not to hybernate the drawing thread.
+	for low rate animations (blinking cursors, clocks) prefer requestFrameAfter() over a session
 	*/
 class AdaptiveVsyncHandler
 {
@@ -205,8 +395,7 @@ public:
 	{
 		if (!redrawRequested)
 		{
-			std::scoped_lock lock(AdaptiveVsyncMux);
-			adaptiveVsync->no_sleep_requests++;
+			adaptiveVsync->no_sleep_requests.fetch_add(1);
 			redrawRequested = true;
 		}
 	}
@@ -215,17 +404,20 @@ public:
 	{
 		if (redrawRequested)
 		{
-			std::scoped_lock lock(AdaptiveVsyncMux);
-			adaptiveVsync->no_sleep_requests--;
+			adaptiveVsync->no_sleep_requests.fetch_sub(1);
 			redrawRequested = false;
 		}
 	}
 
+	void requestFrameAfter(Uint32 _ms)
+	{
+		adaptiveVsync->requestFrameAfter(_ms);
+	}
+
 	bool shouldReDrawFrame()const
 	{
 		return redrawRequested;
 	}
-
 	~AdaptiveVsyncHandler()
 	{
 		stopRedrawSession();
@@ -237,6 +429,694 @@ private:
 	AdaptiveVsync *adaptiveVsync = nullptr;
 };
 
+// event types EventRecorder writes and EventReplayer feeds back: input and window events
+inline bool IsRecordableEvent(Uint32 _type)
+{
+	switch (_type)
+	{
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP:
+	case SDL_EVENT_TEXT_INPUT:
+	case SDL_EVENT_TEXT_EDITING:
+	case SDL_EVENT_MOUSE_MOTION:
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+	case SDL_EVENT_MOUSE_WHEEL:
+	case SDL_EVENT_FINGER_DOWN:
+	case SDL_EVENT_FINGER_UP:
+	case SDL_EVENT_FINGER_MOTION:
+	case SDL_EVENT_FINGER_CANCELED:
+		return true;
+	default:
+		return _type >= SDL_EVENT_WINDOW_FIRST and _type <= SDL_EVENT_WINDOW_LAST;
+	}
+}
+
+/*
+	Writes the raw event stream (before EventBatch merges motion) to a binary
+	file. Per event: time since recording started, how many frames passed
+	since the previous event, the SDL_Event bytes with trailing zeros trimmed
+	and, for text events, the text itself.
+	*/
+class EventRecorder
+{
+public:
+	static constexpr char Magic[8] = {'V', 'O', 'L', 'T', 'E', 'V', 'T', '1'};
+
+	bool open(const std::string &_path)
+	{
+		close();
+		out_.open(_path, std::ios::binary | std::ios::trunc);
+		if (not out_.is_open())
+		{
+			GLogger.Log(Logger::Level::Error, "EventRecorder: failed to open", _path);
+			return false;
+		}
+		const uint32_t event_size = sizeof(SDL_Event);
+		out_.write(Magic, sizeof(Magic));
+		out_.write(reinterpret_cast<const char *>(&event_size), sizeof(event_size));
+		start_ns_ = 0;
+		count_ = 0;
+		return true;
+	}
+
+	void close()
+	{
+		if (out_.is_open())
+			out_.close();
+	}
+
+	bool isOpen() const { return out_.is_open(); }
+
+	size_t count() const { return count_; }
+
+	void write(const SDL_Event &_event, uint64_t _frame)
+	{
+		if (not out_.is_open() or not IsRecordableEvent(_event.type))
+			return;
+		if (start_ns_ == 0)
+			start_ns_ = _event.common.timestamp, last_frame_ = _frame;
+
+		SDL_Event ev = _event;
+		const char *text = nullptr;
+		if (ev.type == SDL_EVENT_TEXT_INPUT)
+			text = ev.text.text, ev.text.text = nullptr;
+		else if (ev.type == SDL_EVENT_TEXT_EDITING)
+			text = ev.edit.text, ev.edit.text = nullptr;
+
+		const auto *bytes = reinterpret_cast<const unsigned char *>(&ev);
+		uint16_t len = sizeof(SDL_Event);
+		while (len > 0 and bytes[len - 1] == 0)
+			--len;
+		const uint64_t t_ns = _event.common.timestamp - std::min(start_ns_, _event.common.timestamp);
+		const uint32_t frame_delta = static_cast<uint32_t>(_frame - last_frame_);
+		last_frame_ = _frame;
+		out_.write(reinterpret_cast<const char *>(&t_ns), sizeof(t_ns));
+		out_.write(reinterpret_cast<const char *>(&frame_delta), sizeof(frame_delta));
+		out_.write(reinterpret_cast<const char *>(&len), sizeof(len));
+		out_.write(reinterpret_cast<const char *>(bytes), len);
+		if (ev.type == SDL_EVENT_TEXT_INPUT or ev.type == SDL_EVENT_TEXT_EDITING)
+		{
+			const uint16_t text_len = nullptr != text ? static_cast<uint16_t>(std::min<size_t>(SDL_strlen(text), UINT16_MAX)) : 0;
+			out_.write(reinterpret_cast<const char *>(&text_len), sizeof(text_len));
+			out_.write(text, text_len);
+		}
+		++count_;
+	}
+
+private:
+	std::ofstream out_;
+	Uint64 start_ns_ = 0;
+	uint64_t last_frame_ = 0;
+	size_t count_ = 0;
+};
+
+/*
+	Feeds a file written by EventRecorder back through EventBatch, keeping
+	the recorded frame grouping so motion is merged exactly as it was.
+	RealTime waits for each group's recorded time, AsFastAsPossible hands
+	one group per frame. Live input is ignored while replaying; quit, render
+	resets and user (wake) events still come through. Event timestamps are
+	rebased on the replay start so velocities come out the same.
+	*/
+class EventReplayer
+{
+public:
+	enum class Speed
+	{
+		RealTime,
+		AsFastAsPossible,
+	};
+
+	struct Report
+	{
+		size_t frames = 0;
+		size_t events = 0;
+		float wall_ms = 0.f;
+		float avg_ms = 0.f, p50_ms = 0.f, p95_ms = 0.f, p99_ms = 0.f, max_ms = 0.f;
+
+		std::string summary() const
+		{
+			char buf[256];
+			SDL_snprintf(buf, sizeof(buf), "replay: %zu frames, %zu events in %.1f ms | frame avg %.2f p50 %.2f p95 %.2f p99 %.2f max %.2f ms",
+						 frames, events, wall_ms, avg_ms, p50_ms, p95_ms, p99_ms, max_ms);
+			return buf;
+		}
+	};
+
+	bool open(const std::string &_path, Speed _speed)
+	{
+		groups_.clear();
+		std::ifstream in(_path, std::ios::binary);
+		char magic[sizeof(EventRecorder::Magic)];
+		uint32_t event_size = 0;
+		if (not in.read(magic, sizeof(magic)) or SDL_memcmp(magic, EventRecorder::Magic, sizeof(magic)) != 0 or
+			not in.read(reinterpret_cast<char *>(&event_size), sizeof(event_size)) or event_size != sizeof(SDL_Event))
+		{
+			GLogger.Log(Logger::Level::Error, "EventReplayer: not a recording of this build", _path);
+			return false;
+		}
+		uint64_t t_ns;
+		uint32_t frame_delta;
+		uint16_t len;
+		while (in.read(reinterpret_cast<char *>(&t_ns), sizeof(t_ns)) and
+			   in.read(reinterpret_cast<char *>(&frame_delta), sizeof(frame_delta)) and
+			   in.read(reinterpret_cast<char *>(&len), sizeof(len)))
+		{
+			Recorded rec;
+			SDL_zero(rec.event);
+			if (len > sizeof(SDL_Event) or not in.read(reinterpret_cast<char *>(&rec.event), len))
+				break;
+			rec.t_ns = t_ns;
+			if (rec.event.type == SDL_EVENT_TEXT_INPUT or rec.event.type == SDL_EVENT_TEXT_EDITING)
+			{
+				uint16_t text_len = 0;
+				if (not in.read(reinterpret_cast<char *>(&text_len), sizeof(text_len)))
+					break;
+				rec.text.resize(text_len);
+				if (not in.read(rec.text.data(), text_len))
+					break;
+			}
+			if (groups_.empty() or frame_delta != 0)
+				groups_.emplace_back();
+			groups_.back().push_back(std::move(rec));
+		}
+		speed_ = _speed;
+		next_group_ = 0;
+		frame_ms_.clear();
+		events_fed_ = 0;
+		start_ns_ = last_drain_ns_ = 0;
+		active_ = not groups_.empty();
+		finished_ = false;
+		return active_;
+	}
+
+	bool isActive() const { return active_; }
+
+	Speed speed() const { return speed_; }
+
+	EventReplayer &setOnFinished(std::function<void(const Report &)> _callback)
+	{
+		on_finished_ = std::move(_callback);
+		return *this;
+	}
+
+	// live events that still reach the app during a replay
+	static bool KeepsLiveEvent(const SDL_Event &_event)
+	{
+		return _event.type == SDL_EVENT_QUIT or _event.type >= SDL_EVENT_USER or
+			   _event.type == SDL_EVENT_RENDER_TARGETS_RESET or _event.type == SDL_EVENT_RENDER_DEVICE_RESET;
+	}
+
+	// EventBatch::drain in replay mode. Appends the next recorded group to
+	// _out once it is due, waiting at most _max_wait_ms (-1 no limit) for it.
+	// The wait goes through _vsync like a live one: it ends at the next frame
+	// deadline, doesn't happen during a redraw session, and a live event
+	// arriving cuts it short.
+	void fill(std::vector<SDL_Event> &_out, AdaptiveVsync &_vsync, Sint32 _max_wait_ms)
+	{
+		const Uint64 now = SDL_GetTicksNS();
+		if (start_ns_ == 0)
+			start_ns_ = now;
+		else
+			frame_ms_.push_back(static_cast<float>(now - last_drain_ns_) / 1e6f);
+
+		if (next_group_ >= groups_.size())
+		{
+			finish(now);
+			return;
+		}
+		auto &group = groups_[next_group_];
+		if (speed_ == Speed::RealTime)
+		{
+			const Uint64 due = start_ns_ + group.back().t_ns;
+			if (due > now)
+			{
+				const Uint64 wait_ms = (due - now + 999999) / 1000000;
+				const Sint32 ms = _max_wait_ms < 0 ? static_cast<Sint32>(std::min<Uint64>(wait_ms, INT32_MAX))
+												   : static_cast<Sint32>(std::min<Uint64>(wait_ms, static_cast<Uint64>(_max_wait_ms)));
+				_vsync.pollEvent(nullptr, ms);
+				// waiting isn't frame time
+				last_drain_ns_ = SDL_GetTicksNS();
+				if (last_drain_ns_ < due)
+					return;
+			}
+		}
+		for (auto &rec : group)
+		{
+			SDL_Event ev = rec.event;
+			ev.common.timestamp = start_ns_ + rec.t_ns;
+			if (ev.type == SDL_EVENT_TEXT_INPUT)
+				ev.text.text = rec.text.c_str();
+			else if (ev.type == SDL_EVENT_TEXT_EDITING)
+				ev.edit.text = rec.text.c_str();
+			_out.push_back(ev);
+		}
+		events_fed_ += group.size();
+		++next_group_;
+		last_drain_ns_ = SDL_GetTicksNS();
+		// keep the frames coming until the recording is exhausted
+		if (speed_ == Speed::AsFastAsPossible)
+			WakeGui();
+	}
+
+	Report report() const
+	{
+		Report out;
+		out.frames = frame_ms_.size();
+		out.events = events_fed_;
+		out.wall_ms = start_ns_ != 0 ? static_cast<float>(last_drain_ns_ - start_ns_) / 1e6f : 0.f;
+		if (frame_ms_.empty())
+			return out;
+		std::vector<float> sorted = frame_ms_;
+		std::sort(sorted.begin(), sorted.end());
+		auto at = [&sorted](float q) {
+			return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * (sorted.size() - 1) + 0.5f))];
+		};
+		float sum = 0.f;
+		for (float ms : sorted)
+			sum += ms;
+		out.avg_ms = sum / sorted.size();
+		out.p50_ms = at(0.50f), out.p95_ms = at(0.95f), out.p99_ms = at(0.99f);
+		out.max_ms = sorted.back();
+		return out;
+	}
+
+private:
+	struct Recorded
+	{
+		SDL_Event event;
+		uint64_t t_ns = 0;
+		std::string text; // backs event.text.text / event.edit.text while replaying
+	};
+
+	void finish(Uint64 _now)
+	{
+		last_drain_ns_ = _now;
+		active_ = false;
+		if (finished_)
+			return;
+		finished_ = true;
+		if (on_finished_)
+			on_finished_(report());
+	}
+
+	std::vector<std::vector<Recorded>> groups_;
+	size_t next_group_ = 0;
+	Speed speed_ = Speed::RealTime;
+	std::vector<float> frame_ms_;
+	size_t events_fed_ = 0;
+	Uint64 start_ns_ = 0;
+	Uint64 last_drain_ns_ = 0;
+	bool active_ = false;
+	bool finished_ = false;
+	std::function<void(const Report &)> on_finished_;
+};
+
+/*
+	Drains every pending event once per frame so a burst of input costs one
+	update/draw/present instead of one per event. Adjacent motion and wheel
+	events from the same source are merged into a single summarised event
+	(latest position, summed deltas); the raw samples are kept in
+	motionHistory() for velocity/gesture code.
+	*/
+class EventBatch
+{
+public:
+	struct MotionSample
+	{
+		Uint32 type;        // SDL_EVENT_MOUSE_MOTION / _WHEEL / SDL_EVENT_FINGER_*
+		Uint64 pointer_id;  // mouse id or finger id
+		float x, y, dx, dy; // wheel: mouse position, scroll amount
+		Uint64 timestamp;   // ns, SDL event clock
+		uint32_t event;     // index in events() of the event it was merged into
+	};
+
+	static EventBatch &Get()
+	{
+		static EventBatch instance;
+		return instance;
+	}
+
+	EventBatch(const EventBatch &) = delete;
+	EventBatch(EventBatch &&) = delete;
+
+	// blocks for the first event through _vsync (unless a redraw is
+	// requested), then takes whatever else is already queued
+	auto drain(AdaptiveVsync &_vsync, Sint32 _max_wait_ms = -1) -> size_t
+	{
+		events_.clear();
+		motion_history_.clear();
+		++frame_;
+		SDL_Event ev;
+		if (nullptr != replayer_ and replayer_->isActive())
+		{
+			while (SDL_PollEvent(&ev))
+				if (EventReplayer::KeepsLiveEvent(ev))
+					append(ev);
+			replay_buf_.clear();
+			replayer_->fill(replay_buf_, _vsync, events_.empty() ? _max_wait_ms : 0);
+			for (const auto &rev : replay_buf_)
+				append(rev);
+			return events_.size();
+		}
+		if (not _vsync.pollEvent(&ev, _max_wait_ms))
+			return 0;
+		record(ev);
+		append(ev);
+		for (size_t raw = 1; raw < max_events_per_frame_ and SDL_PollEvent(&ev); ++raw)
+		{
+			record(ev);
+			append(ev);
+		}
+		return events_.size();
+	}
+
+	// raw events are written to _recorder until set back to nullptr
+	EventBatch &setRecorder(EventRecorder *_recorder)
+	{
+		recorder_ = _recorder;
+		return *this;
+	}
+
+	// while _replayer is active it replaces live input
+	EventBatch &setReplayer(EventReplayer *_replayer)
+	{
+		replayer_ = _replayer;
+		return *this;
+	}
+
+	const std::vector<SDL_Event> &events() const
+	{
+		return events_;
+	}
+
+	// incremented by every drain(), caches keyed on it are valid for one frame
+	uint64_t frame() const
+	{
+		return frame_;
+	}
+
+	// the event being dispatched right now, nullptr outside of dispatch
+	const SDL_Event *current() const
+	{
+		return current_;
+	}
+
+	void setCurrent(const SDL_Event *_event)
+	{
+		current_ = _event;
+	}
+
+	// every motion/finger/wheel sample drained this frame, oldest first
+	const std::vector<MotionSample> &motionHistory() const
+	{
+		return motion_history_;
+	}
+
+	// SDL timestamp of the oldest raw event merged into _event, its own
+	// timestamp for events that weren't merged or aren't from events()
+	Uint64 oldestTimestamp(const SDL_Event &_event) const
+	{
+		const std::less<const SDL_Event *> before;
+		if (events_.empty() or before(&_event, events_.data()) or not before(&_event, events_.data() + events_.size()))
+			return _event.common.timestamp;
+		const auto index = static_cast<uint32_t>(&_event - events_.data());
+		auto it = std::lower_bound(motion_history_.begin(), motion_history_.end(), index,
+								   [](const MotionSample &sample, uint32_t i) { return sample.event < i; });
+		if (it != motion_history_.end() and it->event == index and it->timestamp != 0)
+			return std::min(it->timestamp, _event.common.timestamp);
+		return _event.common.timestamp;
+	}
+
+	// caps the raw events taken in one frame so an endless stream can't starve rendering
+	EventBatch &setMaxEventsPerFrame(size_t _max)
+	{
+		max_events_per_frame_ = std::max<size_t>(1, _max);
+		return *this;
+	}
+
+private:
+	EventBatch() = default;
+
+	void record(const SDL_Event &_ev)
+	{
+		if (nullptr != recorder_)
+			recorder_->write(_ev, frame_);
+	}
+
+	void append(const SDL_Event &_ev)
+	{
+		const auto index = static_cast<uint32_t>(events_.size());
+		switch (_ev.type)
+		{
+		case SDL_EVENT_MOUSE_MOTION:
+			motion_history_.push_back({_ev.type, _ev.motion.which, _ev.motion.x, _ev.motion.y, _ev.motion.xrel, _ev.motion.yrel, _ev.motion.timestamp, index});
+			if (not events_.empty())
+			{
+				auto &last = events_.back().motion;
+				if (last.type == SDL_EVENT_MOUSE_MOTION and last.which == _ev.motion.which and last.windowID == _ev.motion.windowID)
+				{
+					const float xrel = last.xrel + _ev.motion.xrel, yrel = last.yrel + _ev.motion.yrel;
+					last = _ev.motion;
+					last.xrel = xrel, last.yrel = yrel;
+					motion_history_.back().event = index - 1;
+					return;
+				}
+			}
+			break;
+		case SDL_EVENT_FINGER_MOTION:
+			motion_history_.push_back({_ev.type, _ev.tfinger.fingerID, _ev.tfinger.x, _ev.tfinger.y, _ev.tfinger.dx, _ev.tfinger.dy, _ev.tfinger.timestamp, index});
+			if (not events_.empty())
+			{
+				auto &last = events_.back().tfinger;
+				if (last.type == SDL_EVENT_FINGER_MOTION and last.touchID == _ev.tfinger.touchID and last.fingerID == _ev.tfinger.fingerID)
+				{
+					const float dx = last.dx + _ev.tfinger.dx, dy = last.dy + _ev.tfinger.dy;
+					last = _ev.tfinger;
+					last.dx = dx, last.dy = dy;
+					motion_history_.back().event = index - 1;
+					return;
+				}
+			}
+			break;
+		case SDL_EVENT_FINGER_DOWN:
+		case SDL_EVENT_FINGER_UP:
+			motion_history_.push_back({_ev.type, _ev.tfinger.fingerID, _ev.tfinger.x, _ev.tfinger.y, _ev.tfinger.dx, _ev.tfinger.dy, _ev.tfinger.timestamp, index});
+			break;
+		case SDL_EVENT_MOUSE_WHEEL:
+			motion_history_.push_back({_ev.type, _ev.wheel.which, _ev.wheel.mouse_x, _ev.wheel.mouse_y, _ev.wheel.x, _ev.wheel.y, _ev.wheel.timestamp, index});
+			if (not events_.empty())
+			{
+				auto &last = events_.back().wheel;
+				if (last.type == SDL_EVENT_MOUSE_WHEEL and last.which == _ev.wheel.which and last.direction == _ev.wheel.direction)
+				{
+					const float wx = last.x + _ev.wheel.x, wy = last.y + _ev.wheel.y;
+					last = _ev.wheel;
+					last.x = wx, last.y = wy;
+					motion_history_.back().event = index - 1;
+					return;
+				}
+			}
+			break;
+		default:
+			break;
+		}
+		events_.push_back(_ev);
+	}
+
+	std::vector<SDL_Event> events_;
+	std::vector<MotionSample> motion_history_;
+	const SDL_Event *current_ = nullptr;
+	uint64_t frame_ = 0;
+	size_t max_events_per_frame_ = 512;
+	EventRecorder *recorder_ = nullptr;
+	EventReplayer *replayer_ = nullptr;
+	std::vector<SDL_Event> replay_buf_;
+};
+
+/*
+	Paces continuous redraws (open redraw sessions): vsync interval 1 where the
+	renderer supports it, plus a precise sleep until the next frame deadline when
+	the cap is below the display refresh rate. Only continuous frames sleep, so an
+	event driven frame (tap, typing) waits at most for the next refresh, and not
+	at all with setVsyncEnabled(false).
+	The PERFOMANCE_MODE picks the policy:
+		NORMAL          capped at 60 fps
+		BATTERY_SAVER   capped at 30 fps, effectsEnabled() == false
+		HIGH            the display refresh rate
+	*/
+class FramePacer
+{
+public:
+	struct Stats
+	{
+		uint64_t frames = 0;
+		uint64_t missed = 0;      // continuous frames presented later than 1.5x the budget
+		float last_frame_ms = 0.f; // present to present, continuous frames only
+		float budget_ms = 0.f;
+	};
+
+	static FramePacer &Get()
+	{
+		static FramePacer instance;
+		return instance;
+	}
+
+	FramePacer(const FramePacer &) = delete;
+	FramePacer(FramePacer &&) = delete;
+
+	FramePacer &attach(SDL_Renderer *_renderer, float _display_hz)
+	{
+		renderer_ = _renderer;
+		display_hz_ = _display_hz > 1.f ? _display_hz : 60.f;
+		apply();
+		return *this;
+	}
+
+	FramePacer &setMode(PERFOMANCE_MODE _mode)
+	{
+		mode_ = _mode;
+		apply();
+		return *this;
+	}
+
+	PERFOMANCE_MODE getMode() const
+	{
+		return mode_;
+	}
+
+	// overrides the mode's fps cap, 0 goes back to the mode's cap
+	FramePacer &setTargetFps(float _fps)
+	{
+		target_fps_override_ = std::max(0.f, _fps);
+		apply();
+		return *this;
+	}
+
+	FramePacer &setVsyncEnabled(bool _enabled)
+	{
+		vsync_enabled_ = _enabled;
+		apply();
+		return *this;
+	}
+
+	FramePacer &setOnMissedDeadline(std::function<void(float _frame_ms, float _budget_ms)> _callback)
+	{
+		on_missed_deadline_ = std::move(_callback);
+		return *this;
+	}
+
+	// widgets skip purely decorative animations when this is false
+	bool effectsEnabled() const
+	{
+		return mode_ != PERFOMANCE_MODE::BATTERY_SAVER;
+	}
+
+	float getTargetFps() const
+	{
+		return target_fps_;
+	}
+
+	bool isVsyncActive() const
+	{
+		return vsync_active_;
+	}
+
+	const Stats &stats() const
+	{
+		return stats_;
+	}
+
+	// call right after SDL_RenderPresent, _continuous is true while a redraw session is open
+	void endFrame(bool _continuous)
+	{
+		const Uint64 now = SDL_GetTicksNS();
+		++stats_.frames;
+		if (not _continuous)
+		{
+			last_present_ns_ = 0;
+			return;
+		}
+		if (last_present_ns_ != 0)
+		{
+			const Uint64 interval = now - last_present_ns_;
+			stats_.last_frame_ms = static_cast<float>(interval) / 1e6f;
+			if (interval > period_ns_ + period_ns_ / 2)
+			{
+				++stats_.missed;
+				if (on_missed_deadline_)
+					on_missed_deadline_(stats_.last_frame_ms, stats_.budget_ms);
+			}
+		}
+		last_present_ns_ = now;
+
+		if (not sleep_to_cap_)
+			return;
+		// sleep until one period after the previous frame started, restart the
+		// schedule instead of catching up when we fell behind
+		Uint64 deadline = frame_start_ns_ + period_ns_;
+		if (frame_start_ns_ == 0 or now > deadline + period_ns_)
+			deadline = now;
+		if (deadline > now)
+			SDL_DelayPrecise(deadline - now);
+		frame_start_ns_ = deadline;
+	}
+
+private:
+	FramePacer() = default;
+
+	void apply()
+	{
+		float cap = display_hz_;
+		if (mode_ == PERFOMANCE_MODE::NORMAL)
+			cap = std::min(60.f, display_hz_);
+		else if (mode_ == PERFOMANCE_MODE::BATTERY_SAVER)
+			cap = std::min(30.f, display_hz_);
+		if (target_fps_override_ > 0.f)
+			cap = target_fps_override_;
+		target_fps_ = cap;
+		period_ns_ = static_cast<Uint64>(1e9 / cap);
+		stats_.budget_ms = 1000.f / cap;
+		frame_start_ns_ = 0;
+
+		float vsync_rate = 0.f;
+		vsync_active_ = false;
+		if (nullptr != renderer_)
+		{
+			if (vsync_enabled_)
+			{
+				// never an interval above 1, that would hold back event driven frames
+				// too; lower caps come from the sleep in endFrame()
+				if (SDL_SetRenderVSync(renderer_, 1))
+					vsync_active_ = true, vsync_rate = display_hz_;
+			}
+			else
+			{
+				SDL_SetRenderVSync(renderer_, 0);
+			}
+		}
+		sleep_to_cap_ = not vsync_active_ or vsync_rate > cap * 1.05f;
+#ifdef VOLT_PROFILE
+		Profiler::Get().setFrameBudgetMs(stats_.budget_ms);
+#endif
+	}
+
+	SDL_Renderer *renderer_ = nullptr;
+	PERFOMANCE_MODE mode_ = PERFOMANCE_MODE::NORMAL;
+	std::function<void(float, float)> on_missed_deadline_ = nullptr;
+	float display_hz_ = 60.f;
+	float target_fps_ = 60.f;
+	float target_fps_override_ = 0.f;
+	bool vsync_enabled_ = true;
+	bool vsync_active_ = false;
+	bool sleep_to_cap_ = true;
+	Uint64 period_ns_ = 16666667;
+	Uint64 frame_start_ns_ = 0;
+	Uint64 last_present_ns_ = 0;
+	Stats stats_{};
+};
+
 class CacheRenderTarget
 {
 public:
@@ -424,8 +1304,13 @@ class Haptics {
 public:
 	Haptics() = default;
 
+	// Opens the first haptic device. Runs once, play_effect() calls it on
+	// first use so apps that never rumble don't pay for device enumeration.
 	void create()
 	{
+		if (created_)
+			return;
+		created_ = true;
 		// SDL3: Returns bool (true on success)
 		if (!SDL_Init(SDL_INIT_HAPTIC))
 		{
@@ -487,6 +1372,7 @@ public:
 
 	void play_effect()
 	{
+		create();
 		if (haptic_dev.get() != nullptr && effect_id >= 0)
 		{
 			// SDL3: Returns bool (true on success)
@@ -505,13 +1391,14 @@ public:
 			{
 				SDL_DestroyHapticEffect(haptic_dev.get(), effect_id);
 			}
+			GLogger.Log(Logger::Level::Info, "Haptic device closed.");
 		}
-		GLogger.Log(Logger::Level::Info, "Haptic device closed.");
 	}
 
 private:
 	SharedHaptic haptic_dev = nullptr;
 	int effect_id = -1;
+	bool created_ = false;
 };
 
 
@@ -975,50 +1862,410 @@ private:
 			break;
 		}
 
-		return true;
+		return true;
+	}
+
+	TTF_Font* m_font = nullptr;
+	FontStore fontStore;
+	FontAttributes m_font_attributes;
+	int m_font_outline = 0;
+	int m_custom_fontstyle;
+};
+
+
+
+
+
+struct IViewAttributes
+{
+	SDL_FRect bounds = {0.f, 0.f, 0.f, 0.f};
+	SDL_FRect min_bounds = {0.f, 0.f, 1.f, 1.f};
+	float rel_x = 0.f, rel_y = 0.f;
+	Volt::StringId label = "nolabel";
+	Volt::StringId type = "";
+	Volt::StringId action = "default";
+	Volt::StringId id = "null";
+	bool required = false;
+	bool is_form = false;
+	bool prevent_default_behaviour = false;
+	bool hidden = false;
+	bool disabled = false;
+};
+
+// what a view wants to receive from ViewTree, see IView::subscribeEvents
+enum EventCategory : uint32_t
+{
+	EVC_NONE = 0,
+	EVC_POINTER = 1u << 0,        // mouse buttons/motion/wheel, fingers
+	EVC_KEYBOARD = 1u << 1,
+	EVC_TEXT_INPUT = 1u << 2,     // text input and IME editing
+	EVC_WINDOW = 1u << 3,
+	EVC_RENDER_RESET = 1u << 4,   // render targets/device reset
+	EVC_OTHER = 1u << 5,          // quit, user and wake events, everything else
+	EVC_GESTURE = 1u << 6,        // recognised gestures, see IView::onGesture
+	EVC_ALL = 0xffffffffu,
+};
+
+inline uint32_t EventCategoryOf(Uint32 _type)
+{
+	switch (_type)
+	{
+	case SDL_EVENT_MOUSE_MOTION:
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+	case SDL_EVENT_MOUSE_WHEEL:
+	case SDL_EVENT_FINGER_DOWN:
+	case SDL_EVENT_FINGER_UP:
+	case SDL_EVENT_FINGER_MOTION:
+	case SDL_EVENT_FINGER_CANCELED:
+		return EVC_POINTER;
+	case SDL_EVENT_KEY_DOWN:
+	case SDL_EVENT_KEY_UP:
+		return EVC_KEYBOARD;
+	case SDL_EVENT_TEXT_INPUT:
+	case SDL_EVENT_TEXT_EDITING:
+		return EVC_TEXT_INPUT;
+	case SDL_EVENT_RENDER_TARGETS_RESET:
+	case SDL_EVENT_RENDER_DEVICE_RESET:
+		return EVC_RENDER_RESET;
+	default:
+		if (_type >= SDL_EVENT_WINDOW_FIRST and _type <= SDL_EVENT_WINDOW_LAST)
+			return EVC_WINDOW;
+		return EVC_OTHER;
+	}
+}
+
+/*
+	Startup timeline. Application::create() records each startup step as a
+	span relative to the start of create(), steps on other threads included;
+	the first SDL_RenderPresent stamps the time to first present and the
+	timeline is logged once the work deferred past the first frame is done. setOnFirstPresent() hands the report to apps
+	that ship it elsewhere.
+	*/
+class StartupTimeline
+{
+public:
+	struct Step
+	{
+		std::string name;
+		Uint64 begin_ns = 0, end_ns = 0; // since begin()
+		bool ui_thread = true;
+	};
+
+	// RAII span, records on destruction
+	class Scope
+	{
+	public:
+		explicit Scope(const char *_name) : name_(_name), begin_ns_(StartupTimeline::Get().now()) {}
+		~Scope() { StartupTimeline::Get().record(name_, begin_ns_, StartupTimeline::Get().now()); }
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		const char *name_;
+		Uint64 begin_ns_;
+	};
+
+	StartupTimeline(const StartupTimeline &) = delete;
+	StartupTimeline(StartupTimeline &&) = delete;
+
+	static StartupTimeline &Get()
+	{
+		static StartupTimeline instance;
+		return instance;
+	}
+
+	// start of create(), resets a previous run
+	void begin()
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		origin_ns_ = SDL_GetTicksNS();
+		ui_thread_ = std::this_thread::get_id();
+		steps_.clear();
+		first_present_ns_ = 0;
+		finished_ = false;
+	}
+
+	Uint64 now() const { return SDL_GetTicksNS() - origin_ns_; }
+
+	// thread safe
+	void record(std::string _name, Uint64 _begin_ns, Uint64 _end_ns)
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		steps_.push_back({std::move(_name), _begin_ns, _end_ns, std::this_thread::get_id() == ui_thread_});
+	}
+
+	// gui thread, right after SDL_RenderPresent; only the first call counts
+	void onPresent()
+	{
+		if (first_present_ns_ != 0 or origin_ns_ == 0)
+			return;
+		first_present_ns_ = std::max<Uint64>(1, now());
+	}
+
+	// logs the report once the post-first-frame work has been recorded too
+	void finish()
+	{
+		if (first_present_ns_ == 0 or finished_)
+			return;
+		finished_ = true;
+		const std::string text = report();
+		GLogger.Log(Logger::Level::Info, text);
+		if (on_first_present_)
+			on_first_present_(first_present_ns_, text);
+	}
+
+	bool hasPresented() const { return first_present_ns_ != 0; }
+	// 0 until the first frame is on screen
+	Uint64 timeToFirstPresentNs() const { return first_present_ns_; }
+
+	std::vector<Step> steps() const
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		return steps_;
+	}
+
+	std::string report() const
+	{
+		auto ordered = steps();
+		std::stable_sort(ordered.begin(), ordered.end(), [](const Step &a, const Step &b)
+						 { return a.begin_ns < b.begin_ns; });
+		char line[160];
+		std::string out = "startup timeline:";
+		for (const auto &st : ordered)
+		{
+			SDL_snprintf(line, sizeof(line), "\n  %8.2fms +%7.2fms  %s%s", st.begin_ns / 1e6, (st.end_ns - st.begin_ns) / 1e6,
+						 st.name.c_str(), st.ui_thread ? "" : " (background)");
+			out += line;
+		}
+		SDL_snprintf(line, sizeof(line), "\n  time to first present: %.2fms", first_present_ns_ / 1e6);
+		out += line;
+		return out;
+	}
+
+	StartupTimeline &setOnFirstPresent(std::function<void(Uint64, const std::string &)> _cb)
+	{
+		on_first_present_ = std::move(_cb);
+		return *this;
+	}
+
+private:
+	StartupTimeline() = default;
+
+	mutable std::mutex mtx_;
+	std::vector<Step> steps_;
+	std::thread::id ui_thread_;
+	Uint64 origin_ns_ = 0;
+	Uint64 first_present_ns_ = 0;
+	bool finished_ = false;
+	std::function<void(Uint64, const std::string &)> on_first_present_;
+};
+
+/*
+	Input-to-present latency, off by default. Every dispatched input event
+	(pointer, keyboard, text input) is remembered with its SDL timestamp until
+	the next SDL_RenderPresent; the present stamps all of them with the frame
+	that reflected them. Merged motion and wheel events count from the oldest
+	raw sample merged into them. The last SampleHistory latencies are kept per category
+	for percentiles, setOnSample() gets every sample for logging across runs.
+	*/
+class LatencyTracker
+{
+public:
+	static constexpr size_t SampleHistory = 1024;
+	// events waiting for a present, the rest of a bigger burst isn't measured
+	static constexpr size_t MaxPending = 512;
+
+	struct Sample
+	{
+		uint32_t category = EVC_NONE;
+		Uint32 event_type = 0;
+		Uint64 event_ns = 0;   // SDL event timestamp
+		Uint64 present_ns = 0; // right after SDL_RenderPresent
+		uint64_t frame = 0;    // EventBatch frame that dispatched the event
+		float ms() const { return static_cast<float>(present_ns - event_ns) / 1e6f; }
+	};
+
+	struct Percentiles
+	{
+		float p50 = 0.f, p95 = 0.f, p99 = 0.f, max = 0.f;
+		size_t count = 0;
+	};
+
+	static LatencyTracker &Get()
+	{
+		static LatencyTracker instance;
+		return instance;
+	}
+
+	LatencyTracker(const LatencyTracker &) = delete;
+	LatencyTracker(LatencyTracker &&) = delete;
+
+	LatencyTracker &setEnabled(bool _enabled)
+	{
+		enabled_ = _enabled;
+		if (not enabled_)
+			pending_count_ = 0;
+		return *this;
+	}
+
+	bool isEnabled() const { return enabled_; }
+
+	// showing the overlay turns tracking on, it has nothing to show otherwise
+	LatencyTracker &setOverlayVisible(bool _visible)
+	{
+		overlay_visible_ = _visible;
+		if (_visible)
+			enabled_ = true;
+		return *this;
+	}
+
+	bool isOverlayVisible() const { return overlay_visible_; }
+
+	LatencyTracker &setOnSample(std::function<void(const Sample &)> _callback)
+	{
+		on_sample_ = std::move(_callback);
+		return *this;
+	}
+
+	// gui thread, for every event the loop dispatches
+	void onDispatch(const SDL_Event &_event, uint64_t _frame)
+	{
+		if (not enabled_ or _event.common.timestamp == 0)
+			return;
+		const uint32_t category = EventCategoryOf(_event.type);
+		if (slotOf(category) < 0 or pending_count_ == MaxPending)
+			return;
+		// a merged motion/wheel event waited since its oldest sample arrived
+		pending_[pending_count_++] = {category, _event.type, EventBatch::Get().oldestTimestamp(_event), 0, _frame};
 	}
 
-	TTF_Font* m_font = nullptr;
-	FontStore fontStore;
-	FontAttributes m_font_attributes;
-	int m_font_outline = 0;
-	int m_custom_fontstyle;
-};
+	// gui thread, right after SDL_RenderPresent
+	void onPresent()
+	{
+		if (pending_count_ == 0)
+			return;
+		const Uint64 now = SDL_GetTicksNS();
+		for (size_t i = 0; i < pending_count_; ++i)
+		{
+			auto &sample = pending_[i];
+			sample.present_ns = std::max(now, sample.event_ns);
+			auto &ring = history_[slotOf(sample.category)];
+			ring.samples[ring.head] = sample.ms();
+			ring.head = (ring.head + 1) % SampleHistory;
+			ring.count = std::min(ring.count + 1, SampleHistory);
+			if (on_sample_)
+				on_sample_(sample);
+		}
+		pending_count_ = 0;
+	}
+
+	// over the last SampleHistory samples of one category, eg. EVC_TEXT_INPUT
+	Percentiles percentiles(EventCategory _category) const
+	{
+		Percentiles out;
+		const int slot = slotOf(_category);
+		if (slot < 0 or history_[slot].count == 0)
+			return out;
+		const auto &ring = history_[slot];
+		// the overlay asks every frame
+		Volt::FrameVector<float> sorted(ring.samples.begin(), ring.samples.begin() + ring.count, Volt::FrameArena::Get().resource());
+		std::sort(sorted.begin(), sorted.end());
+		auto at = [&sorted](float q) {
+			return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * (sorted.size() - 1) + 0.5f))];
+		};
+		out.p50 = at(0.50f), out.p95 = at(0.95f), out.p99 = at(0.99f);
+		out.max = sorted.back();
+		out.count = sorted.size();
+		return out;
+	}
 
+	void clear()
+	{
+		pending_count_ = 0;
+		for (auto &ring : history_)
+			ring.head = ring.count = 0;
+	}
 
+	// top left text block, one line per category with samples
+	void drawOverlay(SDL_Renderer *_renderer) const
+	{
+		static constexpr std::pair<EventCategory, const char *> rows[] = {
+			{EVC_POINTER, "pointer"}, {EVC_KEYBOARD, "keyboard"}, {EVC_TEXT_INPUT, "text"}};
+		char line[96];
+		float y = 8.f;
+		SDL_BlendMode prev_blend;
+		SDL_GetRenderDrawBlendMode(_renderer, &prev_blend);
+		SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_BLEND);
+		SDL_SetRenderDrawColor(_renderer, 0, 0, 0, 170);
+		const SDL_FRect bg = {4.f, 4.f, 8.f * 52.f + 8.f, 12.f * std::size(rows) + 8.f};
+		SDL_RenderFillRect(_renderer, &bg);
+		SDL_SetRenderDrawColor(_renderer, 255, 255, 255, 255);
+		for (const auto &[category, name] : rows)
+		{
+			const auto p = percentiles(category);
+			SDL_snprintf(line, sizeof(line), "%-8s p50 %5.1f p95 %5.1f p99 %5.1f ms n=%zu", name, p.p50, p.p95, p.p99, p.count);
+			SDL_RenderDebugText(_renderer, 8.f, y, line);
+			y += 12.f;
+		}
+		SDL_SetRenderDrawBlendMode(_renderer, prev_blend);
+	}
 
+private:
+	LatencyTracker() = default;
 
+	static int slotOf(uint32_t _category)
+	{
+		switch (_category)
+		{
+		case EVC_POINTER:
+			return 0;
+		case EVC_KEYBOARD:
+			return 1;
+		case EVC_TEXT_INPUT:
+			return 2;
+		default:
+			return -1;
+		}
+	}
 
-struct IViewAttributes
-{
-	SDL_FRect bounds = {0.f, 0.f, 0.f, 0.f};
-	SDL_FRect min_bounds = {0.f, 0.f, 1.f, 1.f};
-	float rel_x = 0.f, rel_y = 0.f;
-	std::string label = "nolabel";
-	std::string type = "";
-	std::string action = "default";
-	std::string id = "null";
-	bool required = false;
-	bool is_form = false;
-	bool prevent_default_behaviour = false;
-	bool hidden = false;
-	bool disabled = false;
+	struct Ring
+	{
+		std::array<float, SampleHistory> samples{};
+		size_t head = 0;
+		size_t count = 0;
+	};
+
+	std::array<Sample, MaxPending> pending_{};
+	size_t pending_count_ = 0;
+	std::array<Ring, 3> history_{};
+	std::function<void(const Sample &)> on_sample_;
+	// off until setEnabled(true)
+	bool enabled_ = false;
+	bool overlay_visible_ = false;
 };
 
+// window space position of a pointer event, false for non pointer events
+inline bool EventPointerPos(const SDL_Event &_event, SDL_FPoint &_pos);
+
+class ViewTree;
+
 class IView
 {
 public:
 	IView() = default;
+	IView(const IView &) = default;
+	IView &operator=(const IView &) = default;
 	virtual ~IView() = default;
 
 public:
 	SDL_FRect bounds = {0.f, 0.f, 0.f, 0.f};
-	SDL_FRect min_bounds = {0.f, 0.f, 1.f, 1.f};
 	float rel_x = 0.f, rel_y = 0.f;
-	std::string label = "nolabel";
-	std::string type = "";
-	std::string action = "default";
-	std::string id = "null";
+	// interned, 4 bytes each; compare with == against ids or plain strings
+	Volt::StringId label = "nolabel";
+	Volt::StringId type = "";
+	Volt::StringId action = "default";
+	Volt::StringId id = "null";
 	bool required = false;
 	bool is_form = false;
 	bool prevent_default_behaviour = false;
@@ -1026,10 +2273,19 @@ public:
 	bool disabled = false;
 	bool auto_hide = false;
 	// bool relative_pos = false;
-	std::function<void()> onHideCallback = nullptr;
-	std::function<void(IView*)> onToggleCallback = nullptr;
+	// Stored inline, toggling or hiding never allocates. Four pointers of
+	// capture is enough for a std::function or [this, &a, &b] without
+	// every view paying for the default buffer.
+	using HideCallback = Volt::InplaceFunction<void(), 4 * sizeof(void *)>;
+	using ToggleCallback = Volt::InplaceFunction<void(IView *), 4 * sizeof(void *)>;
+	HideCallback onHideCallback = nullptr;
+	ToggleCallback onToggleCallback = nullptr;
 	std::vector<IView *> childViews;
 	IView* linked_view = nullptr;
+	// EventCategory bits ViewTree routes to this view. Everything by default;
+	// the built-in widgets narrow it in Build() to what they handle, containers
+	// forwarding to their children (CellBlock, Menu) keep everything.
+	uint32_t event_mask = EVC_ALL;
 
 public:
 	IView *getView()
@@ -1050,6 +2306,7 @@ public:
 	virtual void attachRelativeView(IView *_prev_view, float _margin = 0.f)
 	{
 		bounds.y = _prev_view->bounds.y + _prev_view->bounds.h + _margin;
+		markGeometryDirty();
 	}
 
 	IView *clearAndAddChildView(IView *_child)
@@ -1078,36 +2335,67 @@ public:
 	void setBoundsBox(const SDL_FRect &_bounds, const SDL_FRect &_min_bounds = {0.f})
 	{
 		bounds = _bounds;
+		markGeometryDirty();
 	}
 
+	// Tells the ViewTree holding this view that bounds or hidden/disabled
+	// changed, so it re-reads just this view. The setters below, hide, show,
+	// enable and disable call it; code writing bounds directly once the view
+	// is in a tree has to call it too.
+	inline void markGeometryDirty();
+
 	virtual void updatePosBy(float dx, float dy)
 	{
 		bounds.x += dx, bounds.y += dy;
+		markGeometryDirty();
 	};
 
 	virtual void setPos(float x, float y)
 	{
 		bounds.x = x, bounds.y = y;
+		markGeometryDirty();
 	};
 
 	virtual void updatePosX(float x)
 	{
 		bounds.x = x;
+		markGeometryDirty();
 	};
 
 	virtual void updatePosY(float y)
 	{
 		bounds.y = y;
+		markGeometryDirty();
 	};
 
-	void setOnHide(std::function<void()> _onHideCallback)
+	// new frame from a ViewLayout, in window pixels. Widgets that cache
+	// textures for their size override this to rebuild them.
+	virtual void onLayout(const SDL_FRect &_frame)
+	{
+		setPos(_frame.x - rel_x, _frame.y - rel_y);
+		bounds.w = _frame.w, bounds.h = _frame.h;
+		markGeometryDirty();
+	}
+
+	void setOnHide(HideCallback _onHideCallback)
+	{
+		onHideCallback = std::move(_onHideCallback);
+	}
+
+	// limit the events ViewTree dispatches to this view, eg. EVC_POINTER | EVC_KEYBOARD
+	void subscribeEvents(uint32_t _mask)
 	{
-		onHideCallback = _onHideCallback;
+		event_mask = _mask;
 	}
 
-	void setOnToggle(std::function<void(IView*)> _onToggleCallback)
+	bool isSubscribed(uint32_t _category) const
 	{
-		onToggleCallback = _onToggleCallback;
+		return (event_mask & _category) != 0;
+	}
+
+	void setOnToggle(ToggleCallback _onToggleCallback)
+	{
+		onToggleCallback = std::move(_onToggleCallback);
 	}
 
 	virtual void linkView(IView* link_view) {
@@ -1140,6 +2428,7 @@ public:
 		for (auto child : childViews)
 			child->hide();
 		hidden = true;
+		markGeometryDirty();
 		if (onHideCallback)
 			onHideCallback();
 		return this;
@@ -1152,6 +2441,7 @@ public:
 		if (linked_view)
 			linked_view->show();
 		hidden = false;
+		markGeometryDirty();
 		return this;
 	}
 
@@ -1160,6 +2450,7 @@ public:
 		for (auto child : childViews)
 			child->disable();
 		disabled = true;
+		markGeometryDirty();
 		return this;
 	}
 	IView *enable()
@@ -1167,6 +2458,7 @@ public:
 		for (auto child : childViews)
 			child->enable();
 		disabled = false;
+		markGeometryDirty();
 		return this;
 	}
 
@@ -1174,6 +2466,11 @@ public:
 
 	virtual bool handleEvent() = 0;
 
+	// tap, long press, drag, fling and pinch recognised by InputStage, in
+	// window pixels. Return true to consume it; a view accepting DragStart or
+	// PinchStart receives the rest of that gesture.
+	virtual bool onGesture(const Gesture::Event &) { return false; }
+
 	virtual void onUpdate() {};
 
 	virtual void draw() = 0;
@@ -1205,6 +2502,20 @@ public:
 	}
 
 private:
+	friend class ViewTree;
+	// the tree mirroring this view's geometry and the slot it sits in. A copy
+	// isn't in any tree; an assigned-to view keeps its own slot and marks it
+	// dirty, it never picks up the source's.
+	struct GeoLink
+	{
+		ViewTree *tree = nullptr;
+		uint32_t slot = 0;
+
+		GeoLink() = default;
+		GeoLink(const GeoLink &) noexcept {}
+		inline GeoLink &operator=(const GeoLink &) noexcept;
+	};
+	GeoLink geo_;
 };
 
 
@@ -1247,180 +2558,896 @@ public:
 		return false;
 	}
 
-	void onUpdate()override final
+	void onUpdate()override final
+	{
+		if (not hidden and not (nullptr == active_vw))
+		{
+			active_vw->onUpdate();
+		}
+	};
+
+	void forceDrawAll()
+	{
+		for (auto& [label,view] : views)
+			view->draw();
+	}
+
+	void draw()override final
+	{
+		if (not hidden and not (nullptr == active_vw))
+		{
+			VOLT_PROFILE_VIEW(active_vw);
+			active_vw->draw();
+		}
+	}
+private:
+	IView* active_vw=nullptr;
+	std::unordered_map<std::string, IView*> views;
+};
+
+
+
+// Names a view registered in a ViewTree. The generation makes a handle go
+// stale once its view is removed, even after the slot is reused.
+struct ViewHandle
+{
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+	uint32_t index = InvalidIndex;
+	uint32_t generation = 0;
+
+	bool valid() const { return index != InvalidIndex; }
+	bool operator==(const ViewHandle &) const = default;
+};
+
+/*
+	Views live in a slot map: lookup, insert and remove through a ViewHandle
+	are O(1) and a handle stays valid until its own view is removed. Draw
+	order is the insertion order, kept as a linked list through the slots;
+	the flat order used for traversal is rebuilt lazily after changes.
+	Labels are an optional secondary index. Geometry and flags are mirrored
+	per slot into parallel arrays that hit grid rebuilds and culling scan
+	instead of chasing view pointers. A view reports its own changes through
+	IView::markGeometryDirty(), only those slots are copied again.
+	A view's changes are reported to the last tree it was added to.
+	*/
+class ViewTree
+{
+public:
+	ViewTree() = default;
+	// views point back at their tree
+	ViewTree(const ViewTree &) = delete;
+	ViewTree &operator=(const ViewTree &) = delete;
+
+	~ViewTree()
+	{
+		for (auto &slot : slots_)
+			if (nullptr != slot.view and slot.view->geo_.tree == this)
+				slot.view->geo_.tree = nullptr;
+		auto &roots = gestureRoots();
+		roots.erase(std::remove(roots.begin(), roots.end(), this), roots.end());
+	}
+
+	// Hands a recognised gesture to the trees that took pointer events at the
+	// top level, in the order they got them. Trees nested in a view only see
+	// gestures the view forwards from its onGesture().
+	static bool dispatchGesture(const Gesture::Event &_gesture)
+	{
+		auto &roots = gestureRoots();
+		bool handled = false;
+		for (size_t i = 0; i < roots.size(); ++i)
+		{
+			if (not handled)
+				handled = roots[i]->handleGesture(_gesture);
+			// a new gesture ends whatever the other trees still hold
+			else if (not isContinuation(_gesture))
+				roots[i]->gesture_capture_ = nullptr;
+		}
+		return handled;
+	}
+
+	ViewHandle addView(IView *iview)
+	{
+		uint32_t index;
+		if (free_head_ != ViewHandle::InvalidIndex)
+		{
+			index = free_head_;
+			free_head_ = slots_[index].next;
+		}
+		else
+		{
+			index = static_cast<uint32_t>(slots_.size());
+			slots_.emplace_back();
+		}
+		Slot &slot = slots_[index];
+		slot.view = iview;
+		slot.prev = tail_;
+		slot.next = ViewHandle::InvalidIndex;
+		if (tail_ != ViewHandle::InvalidIndex)
+			slots_[tail_].next = index;
+		else
+			head_ = index;
+		tail_ = index;
+		++count_;
+		for (auto *geo : {&geo_x_, &geo_y_, &geo_w_, &geo_h_})
+			geo->resize(slots_.size());
+		geo_flags_.resize(slots_.size());
+		geo_flags_[index] = 0;
+		iview->geo_.tree = this;
+		iview->geo_.slot = index;
+		markSlotDirty(index);
+		invalidateOrder();
+		return {index, slot.generation};
+	}
+
+	ViewHandle addView(const std::string &label, IView *iview)
+	{
+		const ViewHandle handle = addView(iview);
+		slots_[handle.index].label = label;
+		labels_[label] = handle;
+		return handle;
+	}
+
+	void removeView(ViewHandle handle)
+	{
+		if (not contains(handle))
+			return;
+		Slot &slot = slots_[handle.index];
+		if (gesture_capture_ == slot.view)
+			gesture_capture_ = nullptr;
+		if (not slot.label.empty())
+		{
+			auto it = labels_.find(slot.label);
+			if (it != labels_.end() and it->second == handle)
+				labels_.erase(it);
+			slot.label.clear();
+		}
+		if (slot.prev != ViewHandle::InvalidIndex)
+			slots_[slot.prev].next = slot.next;
+		else
+			head_ = slot.next;
+		if (slot.next != ViewHandle::InvalidIndex)
+			slots_[slot.next].prev = slot.prev;
+		else
+			tail_ = slot.prev;
+		if (slot.view->geo_.tree == this)
+			slot.view->geo_.tree = nullptr;
+		geo_flags_[handle.index] &= GeoQueued;
+		slot.view = nullptr;
+		++slot.generation;
+		slot.prev = ViewHandle::InvalidIndex;
+		slot.next = free_head_;
+		free_head_ = handle.index;
+		--count_;
+		invalidateOrder();
+	}
+
+	void removeView(const std::string &label)
+	{
+		removeView(handleOf(label));
+	}
+
+	bool contains(ViewHandle handle) const
+	{
+		return handle.index < slots_.size() and slots_[handle.index].generation == handle.generation and
+			   nullptr != slots_[handle.index].view;
+	}
+
+	// nullptr for a stale handle
+	IView *get(ViewHandle handle) const
+	{
+		return contains(handle) ? slots_[handle.index].view : nullptr;
+	}
+
+	// invalid handle when no view has the label
+	ViewHandle handleOf(const std::string &label) const
+	{
+		auto it = labels_.find(label);
+		return it != labels_.end() ? it->second : ViewHandle{};
+	}
+
+	size_t size() const
+	{
+		return count_;
+	}
+
+	// room for n views in total, for trees built in one go
+	void reserve(size_t n)
+	{
+		slots_.reserve(n);
+		order_.reserve(n);
+		labels_.reserve(n);
+		for (auto *geo : {&geo_x_, &geo_y_, &geo_w_, &geo_h_})
+			geo->reserve(n);
+		geo_flags_.reserve(n);
+		dirty_slots_.reserve(n);
+	}
+
+	// visible views under (x, y), topmost first
+	std::vector<IView *> viewsAt(float x, float y)
+	{
+		std::vector<ViewHandle> hits;
+		hitTest(x, y, hits);
+		std::vector<IView *> out;
+		for (ViewHandle handle : hits)
+			out.push_back(get(handle));
+		return out;
+	}
+
+	IView *topmostViewAt(float x, float y)
+	{
+		ensureHitGrid();
+		const auto top = hit_grid_.topmost(x, y);
+		return top ? get(*top) : nullptr;
+	}
+
+	// Re-reads every view on the next query. Only needed after writing
+	// bounds directly without IView::markGeometryDirty(); window resizes
+	// trigger it on their own.
+	void invalidateGeometry()
+	{
+		geometry_dirty_ = true;
+		hit_grid_dirty_ = true;
+	}
+
+	// called through IView::markGeometryDirty()
+	void markSlotDirty(uint32_t _slot)
+	{
+		if (_slot < geo_flags_.size() and not (geo_flags_[_slot] & GeoQueued))
+		{
+			geo_flags_[_slot] |= GeoQueued;
+			dirty_slots_.push_back(_slot);
+		}
+	}
+
+	// visible views overlapping _area, in draw order
+	std::vector<ViewHandle> viewsIntersecting(const SDL_FRect &_area)
+	{
+		std::vector<ViewHandle> out;
+		forEachIntersecting(_area, [&out](ViewHandle handle, IView &) { out.push_back(handle); });
+		return out;
+	}
+
+	// same walk without building a vector, _visit runs before this returns
+	void forEachIntersecting(const SDL_FRect &_area, Volt::FunctionRef<void(ViewHandle, IView &)> _visit)
+	{
+		ensureGeometry();
+		Traversal walk(*this);
+		const auto &order = orderedHandles();
+		for (size_t i = 0; i < order.size(); ++i)
+			if (IView *iv = get(order[i]); nullptr != iv and geoVisibleIn(order[i].index, _area))
+				_visit(order[i], *iv);
+	}
+
+	// draw() skips views entirely outside _area. Leave it off for trees with
+	// views that paint outside their own bounds (shadows, popups).
+	void setCullRect(const SDL_FRect &_area)
+	{
+		cull_rect_ = _area;
+		cull_ = true;
+	}
+
+	void clearCullRect()
+	{
+		cull_ = false;
+	}
+
+	bool isEmpty()
+	{
+		return count_ == 0;
+	}
+
+	void toggleView(ViewHandle handle)
+	{
+		if (IView *iv = get(handle))
+		{
+			if (iv->isHidden())
+			{
+				iv->show();
+				iv->enable();
+			}
+			else
+			{
+				iv->hide();
+				iv->disable();
+			}
+		}
+	}
+
+	void toggleView(const std::string &label)
+	{
+		toggleView(handleOf(label));
+	}
+
+	void showAndEnable(ViewHandle handle)
+	{
+		if (IView *iv = get(handle))
+		{
+			iv->show();
+			iv->enable();
+		}
+	}
+
+	void showAndEnable(const std::string &label)
+	{
+		showAndEnable(handleOf(label));
+	}
+
+	void hideAndDisable(ViewHandle handle)
+	{
+		if (IView *iv = get(handle))
+		{
+			iv->hide();
+			iv->disable();
+		}
+	}
+
+	void hideAndDisable(const std::string &label)
+	{
+		hideAndDisable(handleOf(label));
+	}
+
+	auto setViewHidden(ViewHandle handle, bool _hidden)
+	{
+		if (IView *iv = get(handle))
+			_hidden ? iv->hide() : iv->show();
+	}
+
+	auto setViewHidden(const std::string &label, bool _hidden)
+	{
+		setViewHidden(handleOf(label), _hidden);
+	}
+
+	auto setViewDisabled(ViewHandle handle, bool _disabled)
+	{
+		if (IView *iv = get(handle))
+			_disabled ? iv->disable() : iv->enable();
+	}
+
+	auto setViewDisabled(const std::string &label, bool _disabled)
+	{
+		setViewDisabled(handleOf(label), _disabled);
+	}
+
+	auto setTreeHidden(bool _hidden)
+	{
+		hidden_ = _hidden;
+	}
+
+	auto setTreeDisabled(bool _disabled)
+	{
+		disabled_ = _disabled;
+	}
+
+	// Only views subscribed to the event's category are called. Pointer events
+	// go to the views under the pointer first (topmost first, looked up in the
+	// hit grid), then to the remaining pointer subscribers so drags, releases
+	// and hover tracking outside still arrive. Views that narrowed their mask
+	// with subscribeEvents() opt out of stray motion: they only get it while
+	// under the pointer, right after it left them, or while a press that
+	// started on them is held.
+	// Views may add or remove views while handling, removed ones are skipped.
+	bool handleEvent()
+	{
+		if (not hidden_ /*and not disabled_*/)
+		{
+			const SDL_Event *ev = EventBatch::Get().current();
+			const uint32_t category = nullptr != ev ? EventCategoryOf(ev->type) : EVC_ALL;
+			if (category == EVC_POINTER and not gesture_root_ and dispatchDepth() == 0)
+				gestureRoots().push_back(this), gesture_root_ = true;
+			DispatchScope scope;
+			SDL_FPoint pt;
+			// widgets rescale their bounds while handling it
+			if (nullptr != ev and (ev->type == EVT_WPSC or ev->type == EVT_WMAX))
+				invalidateGeometry();
+			// the ups of whatever was down won't arrive
+			if (nullptr != ev and ev->type == SDL_EVENT_WINDOW_FOCUS_LOST)
+				pointers_down_ = 0, pressed_.clear();
+			if (category == EVC_POINTER and EventPointerPos(*ev, pt))
+			{
+				// every button and finger counts, one lifting doesn't end another's drag
+				if (ev->type == SDL_EVENT_MOUSE_BUTTON_DOWN or ev->type == SDL_EVENT_FINGER_DOWN)
+					++pointers_down_;
+				else if (pointers_down_ > 0 and (ev->type == SDL_EVENT_MOUSE_BUTTON_UP or ev->type == SDL_EVENT_FINGER_UP or
+												 ev->type == SDL_EVENT_FINGER_CANCELED))
+					--pointers_down_;
+
+				// the previous event's hits move to left_, the views the pointer may just have left
+				std::swap(hovered_, left_);
+				hitTest(pt.x, pt.y, hovered_);
+				const auto &hits = hovered_;
+				if (ev->type == SDL_EVENT_MOUSE_BUTTON_DOWN or ev->type == SDL_EVENT_FINGER_DOWN)
+					pressed_.insert(pressed_.end(), hits.begin(), hits.end());
+				else if (pointers_down_ == 0)
+					pressed_.clear();
+				for (size_t i = 0; i < hits.size(); ++i)
+				{
+					IView *iv = get(hits[i]);
+					if (nullptr != iv and iv->isSubscribed(EVC_POINTER) and iv->handleEvent())
+						return true;
+				}
+				const bool motion = ev->type == SDL_EVENT_MOUSE_MOTION or ev->type == SDL_EVENT_FINGER_MOTION;
+				Traversal walk(*this);
+				const auto &order = orderedHandles();
+				for (auto view_index = order.size(); view_index > 0; --view_index)
+				{
+					const ViewHandle handle = order[view_index - 1];
+					IView *iv = get(handle);
+					if (nullptr == iv or iv->isHidden() or not iv->isSubscribed(EVC_POINTER))
+						continue;
+					if (std::find(hits.begin(), hits.end(), handle) != hits.end())
+						continue;
+					if (motion and iv->event_mask != EVC_ALL and std::find(left_.begin(), left_.end(), handle) == left_.end() and
+						std::find(pressed_.begin(), pressed_.end(), handle) == pressed_.end())
+						continue;
+					if (iv->handleEvent())
+						return true;
+				}
+				return false;
+			}
+			Traversal walk(*this);
+			const auto &order = orderedHandles();
+			for (auto view_index = order.size(); view_index > 0; --view_index)
+			{
+				IView *iv = get(order[view_index - 1]);
+				if (nullptr != iv and not iv->isHidden() and iv->isSubscribed(category))
+					if (iv->handleEvent())
+						return true;
+			}
+		}
+		return false;
+	}
+
+	// Hit-tested like pointer events. Continuation gestures (Drag, DragEnd,
+	// Fling, Pinch, PinchEnd) go straight to the view that took the start.
+	bool handleGesture(const Gesture::Event &_gesture)
+	{
+		if (hidden_)
+			return false;
+		using Gesture::Type;
+		if (isContinuation(_gesture))
+		{
+			// nobody here took the start
+			if (nullptr == gesture_capture_)
+				return false;
+			const bool handled = gesture_capture_->onGesture(_gesture);
+			// kept after DragEnd, a Fling may follow
+			if (_gesture.type == Type::Fling or _gesture.type == Type::PinchEnd)
+				gesture_capture_ = nullptr;
+			return handled;
+		}
+		gesture_capture_ = nullptr;
+		hitTest(_gesture.x, _gesture.y, gesture_hits_);
+		for (size_t i = 0; i < gesture_hits_.size(); ++i)
+		{
+			IView *iv = get(gesture_hits_[i]);
+			if (nullptr != iv and iv->isSubscribed(EVC_GESTURE) and iv->onGesture(_gesture))
+			{
+				if (_gesture.type == Type::DragStart or _gesture.type == Type::PinchStart)
+					gesture_capture_ = iv;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void forceHandleEventAll()
 	{
-		if (not hidden and not (nullptr == active_vw))
+		Traversal walk(*this);
+		const auto &order = orderedHandles();
+		for (size_t i = 0; i < order.size(); ++i)
+			if (IView *view_ = get(order[i]))
+				view_->handleEvent();
+	}
+
+	void onUpdate()
+	{
+		if (not hidden_)
 		{
-			active_vw->onUpdate();
+			Traversal walk(*this);
+			const auto &order = orderedHandles();
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				IView *view = get(order[i]);
+				if (nullptr != view and not view->isHidden())
+					view->onUpdate();
+			}
 		}
 	};
 
 	void forceDrawAll()
 	{
-		for (auto& [label,view] : views)
-			view->draw();
+		Traversal walk(*this);
+		const auto &order = orderedHandles();
+		for (size_t i = 0; i < order.size(); ++i)
+			if (IView *view = get(order[i]))
+				view->draw();
 	}
 
-	void draw()override final
+	void draw()
 	{
-		if (not hidden and not (nullptr == active_vw))
+		if (not hidden_)
 		{
-			active_vw->draw();
+			// picks up whatever moved in onUpdate
+			if (cull_)
+				ensureGeometry();
+			Traversal walk(*this);
+			const auto &order = orderedHandles();
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				if (cull_ and not geoVisibleIn(order[i].index, cull_rect_))
+					continue;
+				IView *view = get(order[i]);
+				if (nullptr != view and not view->isHidden())
+				{
+					VOLT_PROFILE_VIEW(view);
+					view->draw();
+				}
+			}
 		}
 	}
+
+public:
+	IView *operator[](ViewHandle handle) const
+	{
+		return get(handle);
+	}
+
+	IView *operator[](const std::string &label) const
+	{
+		return get(handleOf(label));
+	}
+
 private:
-	IView* active_vw=nullptr;
-	std::unordered_map<std::string, IView*> views;
-};
+	struct Slot
+	{
+		IView *view = nullptr;
+		uint32_t generation = 0;
+		// neighbours in draw order; next doubles as the free list link
+		uint32_t prev = ViewHandle::InvalidIndex, next = ViewHandle::InvalidIndex;
+		std::string label;
+	};
 
+	enum : uint8_t
+	{
+		GeoLive = 1,
+		GeoHidden = 2,
+		GeoDisabled = 4,
+		GeoQueued = 8, // in dirty_slots_
+	};
 
+	void invalidateOrder()
+	{
+		order_dirty_ = true;
+		hit_grid_dirty_ = true;
+	}
 
-class ViewTree
-{
-public:
-	auto addView(const std::string &label, IView *iview)
+	// copies the slots marked dirty, or every slot after invalidateGeometry()
+	void ensureGeometry()
 	{
-		indexer[label] = view_tree.size();
-		return view_tree.emplace_back(iview);
+		if (geometry_dirty_)
+		{
+			for (uint32_t i = 0; i < slots_.size(); ++i)
+				copyGeometry(i);
+			geometry_dirty_ = false;
+			hit_grid_dirty_ = true;
+		}
+		else
+		{
+			for (uint32_t i : dirty_slots_)
+				if (copyGeometry(i))
+					hit_grid_dirty_ = true;
+		}
+		dirty_slots_.clear();
 	}
 
-	auto removeView(const std::string &label)
+	// true when the copy differs from what was there
+	bool copyGeometry(uint32_t i)
 	{
-		if (indexer.contains(label))
+		const IView *iv = slots_[i].view;
+		if (nullptr == iv)
 		{
-			view_tree.erase(view_tree.begin() + indexer[label]);
-			indexer.erase(label);
+			const bool changed = (geo_flags_[i] & ~GeoQueued) != 0;
+			geo_flags_[i] = 0;
+			return changed;
 		}
+		const float x = iv->getRealX(), y = iv->getRealY(), w = iv->bounds.w, h = iv->bounds.h;
+		const uint8_t flags = GeoLive | (iv->isHidden() ? GeoHidden : 0) | (iv->isDisabled() ? GeoDisabled : 0);
+		const bool changed = x != geo_x_[i] or y != geo_y_[i] or w != geo_w_[i] or h != geo_h_[i] or
+							 flags != (geo_flags_[i] & ~GeoQueued);
+		geo_x_[i] = x, geo_y_[i] = y, geo_w_[i] = w, geo_h_[i] = h;
+		geo_flags_[i] = flags;
+		return changed;
 	}
 
-	bool isEmpty()
+	bool geoVisibleIn(uint32_t i, const SDL_FRect &_area) const
 	{
-		return view_tree.empty();
+		if (not (geo_flags_[i] & GeoLive) or (geo_flags_[i] & GeoHidden))
+			return false;
+		return geo_x_[i] < _area.x + _area.w and geo_x_[i] + geo_w_[i] > _area.x and
+			   geo_y_[i] < _area.y + _area.h and geo_y_[i] + geo_h_[i] > _area.y;
 	}
 
-	void toggleView(const std::string &label)
+	// Keeps order_ as it is while a traversal runs, see orderedHandles()
+	struct Traversal
+	{
+		explicit Traversal(ViewTree &_tree) : tree(_tree) { ++tree.traversals_; }
+		~Traversal() { --tree.traversals_; }
+		Traversal(const Traversal &) = delete;
+		ViewTree &tree;
+	};
+
+	// Draw order, back to front. Only rebuilt when no traversal is running,
+	// so loops index it directly instead of copying it: views added while a
+	// loop runs show up in the next one, removed ones resolve to nullptr
+	// through their stale handle. Index, don't iterate; reserve() may move it.
+	const std::vector<ViewHandle> &orderedHandles()
 	{
-		if (indexer.contains(label))
+		if (order_dirty_ and traversals_ == 0)
 		{
-			if (view_tree[indexer[label]]->isHidden())
-			{
-				view_tree[indexer[label]]->show();
-				view_tree[indexer[label]]->enable();
-			}
-			else
-			{
-				view_tree[indexer[label]]->hide();
-				view_tree[indexer[label]]->disable();
-			}
+			order_.clear();
+			order_.reserve(count_);
+			for (uint32_t i = head_; i != ViewHandle::InvalidIndex; i = slots_[i].next)
+				order_.push_back({i, slots_[i].generation});
+			order_dirty_ = false;
 		}
+		return order_;
 	}
 
-	void showAndEnable(const std::string &label)
+	// Rebuilt only when the order changed or a slot's geometry or hidden
+	// flag did, in the grid's own storage.
+	void ensureHitGrid()
 	{
-		if (indexer.contains(label))
+		ensureGeometry();
+		if (not hit_grid_dirty_)
+			return;
+		const auto &order = orderedHandles();
+		hit_grid_.begin();
+		for (size_t i = 0; i < order.size(); ++i)
 		{
-			view_tree[indexer[label]]->show();
-			view_tree[indexer[label]]->enable();
+			const uint32_t g = order[i].index;
+			if ((geo_flags_[g] & (GeoLive | GeoHidden)) == GeoLive)
+				hit_grid_.add(order[i], {geo_x_[g], geo_y_[g], geo_w_[g], geo_h_[g]}, static_cast<int>(i));
 		}
+		hit_grid_.finish();
+		// built from a stale order when asked for mid traversal, redo it after
+		hit_grid_dirty_ = order_dirty_;
 	}
 
-	void hideAndDisable(const std::string &label)
+	static bool isContinuation(const Gesture::Event &_gesture)
 	{
-		if (indexer.contains(label))
-		{
-			view_tree[indexer[label]]->hide();
-			view_tree[indexer[label]]->disable();
-		}
+		using Gesture::Type;
+		return _gesture.type == Type::Drag or _gesture.type == Type::DragEnd or _gesture.type == Type::Fling or
+			   _gesture.type == Type::Pinch or _gesture.type == Type::PinchEnd;
 	}
 
-	auto setViewHidden(const std::string &label, bool _hidden)
+	static std::vector<ViewTree *> &gestureRoots()
 	{
-		if (indexer.contains(label))
-			_hidden ? view_tree[indexer[label]]->hide() : view_tree[indexer[label]]->show();
+		static std::vector<ViewTree *> roots;
+		return roots;
 	}
 
-	auto setViewDisabled(const std::string &label, bool _disabled)
+	// handleEvent() calls in progress, nested trees run at depth > 0
+	static int &dispatchDepth()
 	{
-		if (indexer.contains(label))
-			_disabled ? view_tree[indexer[label]]->disable() : view_tree[indexer[label]]->enable();
+		static int depth = 0;
+		return depth;
 	}
 
-	auto setTreeHidden(bool _hidden)
+	struct DispatchScope
 	{
-		hidden_ = _hidden;
+		DispatchScope() { ++dispatchDepth(); }
+		~DispatchScope() { --dispatchDepth(); }
+	};
+
+	// visible views under (x, y), topmost first, written over _out
+	void hitTest(float x, float y, std::vector<ViewHandle> &_out)
+	{
+		ensureHitGrid();
+		hit_grid_.query(x, y, _out);
 	}
 
-	auto setTreeDisabled(bool _disabled)
+	Spatial::UniformGrid<ViewHandle> hit_grid_;
+	bool hit_grid_dirty_ = true;
+	int pointers_down_ = 0;
+	// views under the pointer now and at the previous pointer event, and
+	// the ones under it when the held buttons/fingers went down
+	std::vector<ViewHandle> hovered_, left_, pressed_, gesture_hits_;
+	IView *gesture_capture_ = nullptr;
+	bool gesture_root_ = false;
+
+	// per slot, see ensureGeometry()
+	std::vector<float> geo_x_, geo_y_, geo_w_, geo_h_;
+	std::vector<uint8_t> geo_flags_;
+	std::vector<uint32_t> dirty_slots_;
+	bool geometry_dirty_ = false;
+	SDL_FRect cull_rect_{0.f, 0.f, 0.f, 0.f};
+	bool cull_ = false;
+
+private:
+	std::vector<Slot> slots_;
+	uint32_t head_ = ViewHandle::InvalidIndex, tail_ = ViewHandle::InvalidIndex;
+	uint32_t free_head_ = ViewHandle::InvalidIndex;
+	size_t count_ = 0;
+	std::vector<ViewHandle> order_;
+	bool order_dirty_ = false;
+	int traversals_ = 0;
+	std::unordered_map<std::string, ViewHandle> labels_;
+	bool hidden_ = false, disabled_;
+	// ViewTree child_tree();
+};
+
+inline void IView::markGeometryDirty()
+{
+	if (nullptr != geo_.tree)
+		geo_.tree->markSlotDirty(geo_.slot);
+}
+
+inline IView::GeoLink &IView::GeoLink::operator=(const GeoLink &) noexcept
+{
+	if (nullptr != tree)
+		tree->markSlotDirty(slot);
+	return *this;
+}
+
+/*
+	Drives view geometry from a Layout::Tree (LayoutCore.hpp) instead of
+	percentages computed in every widget. Nodes can carry a view; update()
+	lays the tree out for an area and calls IView::onLayout only on the views
+	whose frame changed. Text leaves are measured with TTF once per text and
+	font, setText() re-measures just that leaf.
+	*/
+class ViewLayout
+{
+public:
+	ViewLayout()
 	{
-		disabled_ = _disabled;
+		root_ = tree_.create();
 	}
 
-	bool handleEvent()
+	// measure callbacks point back at this
+	ViewLayout(const ViewLayout &) = delete;
+	ViewLayout(ViewLayout &&) = delete;
+
+	Layout::Tree &tree() { return tree_; }
+	Layout::NodeId root() const { return root_; }
+
+	void reserve(size_t n)
 	{
-		if (not hidden_ /*and not disabled_*/)
-		{
-			for (auto view_index = view_tree.size(); view_index > 0; --view_index)
-			{
-				auto &iv = view_tree[view_index - 1];
-				if (not iv->isHidden())
-					if (iv->handleEvent())
-						return true;
-			}
-		}
-		return false;
+		tree_.reserve(n + 1);
+		views_.reserve(n + 1);
 	}
 
-	void forceHandleEventAll()
+	ViewLayout &setRootStyle(const Layout::Style &_style)
 	{
-		for (auto view_ : view_tree)
-			view_->handleEvent();
+		tree_.setStyle(root_, _style);
+		return *this;
 	}
 
-	void onUpdate()
+	Layout::NodeId add(Layout::NodeId _parent, const Layout::Style &_style, IView *_view = nullptr)
 	{
-		if (not hidden_)
-		{
-			for (int view_index = 0; view_index < view_tree.size(); ++view_index)
-			{
-				auto &view = view_tree[view_index];
-				if (not view->isHidden())
-					view->onUpdate();
-			}
-		}
-	};
+		const Layout::NodeId node = tree_.create(_style);
+		tree_.appendChild(_parent, node);
+		bind(node, _view);
+		return node;
+	}
 
-	void forceDrawAll()
+	// leaf sized by its text, single line
+	Layout::NodeId addText(Layout::NodeId _parent, const Layout::Style &_style, const std::string &_text,
+						   const FontAttributes &_font, IView *_view = nullptr)
 	{
-		for (auto view : view_tree)
-			view->draw();
+		const Layout::NodeId node = add(_parent, _style, _view);
+		Text &text = texts_[node];
+		text.text = _text;
+		text.font = _font;
+		tree_.setMeasure(node, [this, node](float, float)
+						 { return measureText(texts_[node]); });
+		return node;
 	}
 
-	void draw()
+	// only marks the node dirty when the text actually changed
+	void setText(Layout::NodeId _node, const std::string &_text)
 	{
-		if (not hidden_)
+		auto it = texts_.find(_node);
+		if (it == texts_.end() or it->second.text == _text)
+			return;
+		it->second.text = _text;
+		it->second.measured = false;
+		tree_.markDirty(_node);
+	}
+
+	void bind(Layout::NodeId _node, IView *_view)
+	{
+		if (views_.size() <= _node)
+			views_.resize(_node + 1, nullptr);
+		views_[_node] = _view;
+	}
+
+	void remove(Layout::NodeId _node)
+	{
+		std::vector<Layout::NodeId> stack{_node};
+		while (not stack.empty())
 		{
-			for (int view_index = 0; view_index < view_tree.size(); ++view_index)
-			{
-				auto &view = view_tree[view_index];
-				if (not view->isHidden())
-					view->draw();
-			}
+			const Layout::NodeId cur = stack.back();
+			stack.pop_back();
+			for (Layout::NodeId ch : tree_.children(cur))
+				stack.push_back(ch);
+			if (cur < views_.size())
+				views_[cur] = nullptr;
+			texts_.erase(cur);
 		}
+		tree_.destroy(_node);
 	}
 
-public:
-	IView *operator[](const std::string &label)
+	// Lays out for _area (window pixels), typically the app bounds from the
+	// EVT_WPSC handler or once per frame; nearly free when nothing changed.
+	void update(const SDL_FRect &_area)
 	{
-		if (indexer.contains(label))
-			return view_tree[indexer[label]];
-		return nullptr;
+		VOLT_PROFILE_SCOPE("layout");
+		if (_area.x != origin_.x or _area.y != origin_.y)
+		{
+			origin_ = {_area.x, _area.y};
+			moved_all_ = true;
+		}
+		tree_.compute(root_, _area.w, _area.h);
+		auto apply = [this](Layout::NodeId node)
+		{
+			if (node >= views_.size() or nullptr == views_[node])
+				return;
+			const Layout::Rect &r = tree_.absoluteFrame(node);
+			views_[node]->onLayout({origin_.x + r.x, origin_.y + r.y, r.w, r.h});
+		};
+		if (moved_all_)
+		{
+			for (Layout::NodeId node = 0; node < views_.size(); ++node)
+				if (tree_.alive(node))
+					apply(node);
+			moved_all_ = false;
+		}
+		else
+		{
+			for (Layout::NodeId node : tree_.changed())
+				apply(node);
+		}
 	}
 
+	const Layout::Tree::Stats &lastStats() const { return tree_.lastStats(); }
+
 private:
-	std::unordered_map<std::string, size_t> indexer;
-	std::vector<IView *> view_tree;
-	bool hidden_ = false, disabled_;
-	// ViewTree child_tree();
+	struct Text
+	{
+		std::string text;
+		FontAttributes font;
+		Layout::Size size;
+		bool measured = false;
+	};
+
+	static Layout::Size measureText(Text &_text)
+	{
+		if (_text.measured)
+			return _text.size;
+		std::string font_file = _text.font.font_file;
+		if (font_file.empty())
+		{
+			// the embedded font, registered for this size like CharStore does
+			MemFont mem = *Fonts[Font::RobotoBold];
+			mem.font_size = _text.font.font_size;
+			FontSystem::Get().getFont(mem);
+			font_file = mem.font_name;
+		}
+		int w = 0, h = 0;
+		if (TTF_Font *font = FontSystem::Get().getFont(font_file, _text.font.font_size))
+			TTF_GetStringSize(font, _text.text.c_str(), 0, &w, &h);
+		_text.size = {static_cast<float>(w), static_cast<float>(h)};
+		_text.measured = true;
+		return _text.size;
+	}
+
+	Layout::Tree tree_;
+	Layout::NodeId root_ = Layout::InvalidNode;
+	std::vector<IView *> views_;
+	std::unordered_map<Layout::NodeId, Text> texts_;
+	SDL_FPoint origin_{0.f, 0.f};
+	bool moved_all_ = true;
 };
 
 class TextArea;
@@ -1509,7 +3536,8 @@ public:
 	}
 
 	inline std::string colorToStr(SDL_Color& col) {
-		return packToString("-", (int)(col.r + col.g), col.b % 127, col.a % 127);
+		char buf[32];
+		return std::string(buf, colorToChars(col, buf, buf + sizeof(buf)));
 	}
 
 	SDL_Texture* getChar(std::string& _txt, SDL_Color& color) {
@@ -1517,19 +3545,30 @@ public:
 			GLogger.Log(Logger::Level::Error, "CharStore::getChar invoked with empty string!");
 			return nullptr;
 		}
-		auto col_txt = colorToStr(color) +_txt;
-		if (not char_textures.contains(col_txt)) {
-			FontSystem::Get().setFontAttributes(fattr, custom_ft_style);
-			auto textTex = FontSystem::Get().genTextTextureRaw(renderer, _txt.c_str(), color);
-			if (textTex != nullptr) {
-				char_textures[col_txt] = textTex;
-			}
-			else {
-				GLogger.Log(Logger::Level::Error, "CharStore::getChar::genText returned null!");
-				return nullptr;
-			}
+		// key built on the stack, a cache hit doesn't allocate
+		char buf[64];
+		char* end = colorToChars(color, buf, buf + sizeof(buf));
+		std::string long_key;
+		std::string_view col_txt;
+		if (_txt.size() <= static_cast<std::size_t>(buf + sizeof(buf) - end)) {
+			std::memcpy(end, _txt.data(), _txt.size());
+			col_txt = std::string_view(buf, static_cast<std::size_t>(end - buf) + _txt.size());
+		}
+		else {
+			// doesn't fit, long keys are rare enough to go to the heap
+			long_key.assign(buf, end).append(_txt);
+			col_txt = long_key;
+		}
+		if (auto it = char_textures.find(col_txt); it != char_textures.end())
+			return it->second;
+		FontSystem::Get().setFontAttributes(fattr, custom_ft_style);
+		auto textTex = FontSystem::Get().genTextTextureRaw(renderer, _txt.c_str(), color);
+		if (textTex == nullptr) {
+			GLogger.Log(Logger::Level::Error, "CharStore::getChar::genText returned null!");
+			return nullptr;
 		}
-		return char_textures[col_txt];
+		char_textures.emplace(std::string(col_txt), textTex);
+		return textTex;
 	}
 
 	void reset() {
@@ -1543,7 +3582,22 @@ public:
 		reset();
 	}
 private:
-	std::unordered_map<std::string, SDL_Texture*> char_textures{};
+	// "r+g-b%127-a%127", the same key colorToStr() gives
+	static char* colorToChars(const SDL_Color& col, char* first, char* last) {
+		first = std::to_chars(first, last, (int)(col.r + col.g)).ptr;
+		*first++ = '-';
+		first = std::to_chars(first, last, col.b % 127).ptr;
+		*first++ = '-';
+		return std::to_chars(first, last, col.a % 127).ptr;
+	}
+
+	// string_view lookups without building a std::string
+	struct KeyHash {
+		using is_transparent = void;
+		std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+	};
+
+	std::unordered_map<std::string, SDL_Texture*, KeyHash, std::equal_to<>> char_textures{};
 	FontAttributes fattr{};
 	int custom_ft_style = 0;
 };
@@ -1600,14 +3654,21 @@ public:
 		fattr = _fattr;
 		fattr.font_size = std::clamp(fattr.font_size, 0.f, 254.f);
 		app_bounds = _app_bounds;
-		char_store.setProps(getContext(), fattr);
+		store_ready = false;
 		GLogger.Log(Logger::Level::Info, "Toast FTS:", (uint8_t)fattr.font_size);
 	}
 
 	void addToast(std::string message, uint64_t duration=3000, SDL_Color bg_col = { 255,255,255,200 }, SDL_Color txt_col = { 0,0,0,255 }, float corner_radius = 25.f) {
 		auto capped_duration = std::clamp(duration, (uint64_t)1, (uint64_t)3000);
-		std::vector<std::vector<SDL_Texture*>> textures{};
-		std::vector<float> heights{};
+		// the font is opened with the first toast, not at startup
+		if (not store_ready) {
+			char_store.setProps(getContext(), fattr);
+			store_ready = true;
+		}
+		// scratch, lives until the end of the frame
+		auto* arena = Volt::FrameArena::Get().resource();
+		Volt::FrameVector<Volt::FrameVector<SDL_Texture*>> textures{ arena };
+		Volt::FrameVector<float> heights{ arena };
 		float max_w = to_cust(70.f,app_bounds.w);
 		float sum_w = 0.f, sum_h = 0.f;
 		float max_ln_h = 0.f;
@@ -1672,30 +3733,30 @@ public:
 			app_bounds.h-to_cust(20.f,app_bounds.h)-th,
 			tw, th
 		};
-		toast_msgs.push_back({ SDL_GetTicks() - trans_duration, SDL_GetTicks(), duration, ch_dst,std::move(ttexr) });
+		toast_msgs.push_back({ Volt::Clock::Get().nowMs() - trans_duration, Volt::Clock::Get().nowMs(), duration, ch_dst,std::move(ttexr) });
 		if (not toast_msgs.empty()) {
 			vsync.startRedrawSession();
 		}
 	}
 
 	void onUpdate() {
-		//SDL_GetTicks()
+		//Volt::Clock::Get().nowMs()
 	}
 
 	void draw() {
 		if (not toast_msgs.empty()) {
 			auto& [strt, time, duration, rect, txr] = toast_msgs.front();
-			const auto elapsed_pause_duration = SDL_GetTicks() - strt;
+			const auto elapsed_pause_duration = Volt::Clock::Get().nowMs() - strt;
 			if (elapsed_pause_duration >= trans_duration) {
-				const auto elapsed = SDL_GetTicks() - time;
+				const auto elapsed = Volt::Clock::Get().nowMs() - time;
 				RenderTexture(renderer, txr.get(), nullptr, &rect);
 				if (elapsed >= duration) {
 					toast_msgs.pop_front();
 					// if not empty update/reset the next entity start time
 					if (not toast_msgs.empty()) {
 						auto& [nxt_strt, nxt_time, duration, nxt_rect, nxt_txr] = toast_msgs.front();
-						nxt_strt = SDL_GetTicks();
-						nxt_time = SDL_GetTicks() + trans_duration;
+						nxt_strt = Volt::Clock::Get().nowMs();
+						nxt_time = Volt::Clock::Get().nowMs() + trans_duration;
 					}
 				}
 			}
@@ -1712,6 +3773,7 @@ private:
 	// <start_time,curr_time, duration, rect, texture>
 	std::deque<std::tuple<uint64_t, uint64_t, uint64_t, SDL_FRect, SharedTexture>> toast_msgs{};
 	CharStore char_store{};
+	bool store_ready = false;
 	FontAttributes fattr{};
 	SDL_FRect app_bounds{0.f,0.f,480.f,720.f};
 	AdaptiveVsyncHandler vsync{};
@@ -1807,32 +3869,281 @@ public:
 	template <typename T>
 	constexpr inline T pw(const T &val) const { return ((val * RenderW) / static_cast<decltype(val)>(100)); }
 
-	// get %val of ref
-	template <typename T>
-	constexpr inline T to_cust(const T& val, const T& ref) const { return ((val * ref) / static_cast<decltype(val)>(100)); }
+	// get %val of ref
+	template <typename T>
+	constexpr inline T to_cust(const T& val, const T& ref) const { return ((val * ref) / static_cast<decltype(val)>(100)); }
+
+	template <typename T>
+	constexpr inline T dpToPx(const T &dp) const
+	{
+		return (DDPI * dp) / 160.f;
+	}
+
+	float RenderH, RenderW, DPRenderH, DPRenderW, DDPI, H_DPI, V_DPI, V_DPI_R, H_DPI_R;
+	float OldRenderH, OldRenderW;
+	int DrawableH, DrawableW;
+	int maxTextureWidth, maxTextureHeight;
+	SDL_DisplayMode mode;
+	DeviceDisplayType display_type;
+
+private:
+	DisplayInfo()
+	{
+		display_type = DeviceDisplayType::Unknown;
+		DrawableH = 0, DrawableW = 0;
+		RenderH = RenderW = DPRenderH = DPRenderW = DDPI = H_DPI = V_DPI = V_DPI_R = H_DPI_R = 1.f;
+	}
+};
+
+/*
+	Debounces window resizes. While the size keeps changing EVT_WPSC and
+	EVT_WMAX are held back from the widgets and the last laid out frame is
+	drawn stretched to the window through SDL_SetRenderScale, so a drag costs
+	no re-layout and no texture regeneration. Once the size has been stable
+	for the settle time the latest held event of each type is dispatched once,
+	in the order the types first arrived, and widgets do their full resize (DisplayInfo's old size is still the pre-drag one,
+	so toUpdatedWidth/Height scale from there in one step).
+	*/
+class ResizeCoordinator
+{
+public:
+	static ResizeCoordinator &Get()
+	{
+		static ResizeCoordinator instance;
+		return instance;
+	}
+
+	ResizeCoordinator(const ResizeCoordinator &) = delete;
+	ResizeCoordinator(ResizeCoordinator &&) = delete;
+
+	ResizeCoordinator &setSettleMs(uint32_t _ms)
+	{
+		settle_ms_ = _ms;
+		return *this;
+	}
+
+	uint32_t getSettleMs() const { return settle_ms_; }
+
+	// disabled, resize events go straight through as before
+	ResizeCoordinator &setEnabled(bool _enabled)
+	{
+		enabled_ = _enabled;
+		return *this;
+	}
+
+	bool isResizing() const { return resizing_; }
+
+	// true when _event is a resize that is held back
+	bool intercept(const SDL_Event &_event)
+	{
+		if (not enabled_ or settle_ms_ == 0 or (_event.type != EVT_WPSC and _event.type != EVT_WMAX))
+			return false;
+		if (not resizing_)
+		{
+			base_w_ = DisplayInfo::Get().RenderW;
+			base_h_ = DisplayInfo::Get().RenderH;
+			resizing_ = true;
+		}
+		// a EVT_WMAX doesn't replace a held EVT_WPSC, widgets may need both
+		size_t slot = 0;
+		while (slot < pending_count_ and pending_[slot].type != _event.type)
+			++slot;
+		pending_[slot] = _event;
+		pending_count_ = std::max(pending_count_, slot + 1);
+		last_change_ns_ = SDL_GetTicksNS();
+		// wakes the loop once the size had time to settle
+		Async::TimerService::Get().cancel(settle_timer_);
+		settle_timer_ = Async::TimerService::Get().setTimeout(settle_ms_ + 1, [] {});
+		return true;
+	}
+
+	// the held back events, one per call, once the size has been stable for the settle time
+	std::optional<SDL_Event> takeSettled()
+	{
+		if (not resizing_ or SDL_GetTicksNS() - last_change_ns_ < static_cast<Uint64>(settle_ms_) * 1000000ull)
+			return std::nullopt;
+		const SDL_Event settled = pending_[taken_++];
+		if (taken_ >= pending_count_)
+			resizing_ = false, pending_count_ = taken_ = 0;
+		return settled;
+	}
+
+	// before drawing the frame, stretches it while resizing and restores the scale after
+	void applyInterimScale(SDL_Renderer *_renderer, SDL_Window *_window)
+	{
+		if (not resizing_)
+		{
+			if (scaled_)
+				SDL_SetRenderScale(_renderer, 1.f, 1.f), scaled_ = false;
+			return;
+		}
+		int w = 0, h = 0;
+		SDL_GetWindowSize(_window, &w, &h);
+		if (base_w_ <= 0.f or base_h_ <= 0.f or w <= 0 or h <= 0)
+			return;
+		SDL_SetRenderScale(_renderer, static_cast<float>(w) / base_w_, static_cast<float>(h) / base_h_);
+		scaled_ = true;
+	}
+
+private:
+	ResizeCoordinator() = default;
+
+	// latest EVT_WPSC / EVT_WMAX, in arrival order
+	std::array<SDL_Event, 2> pending_{};
+	size_t pending_count_ = 0, taken_ = 0;
+	Uint64 last_change_ns_ = 0;
+	Async::TimerId settle_timer_ = 0;
+	float base_w_ = 0.f, base_h_ = 0.f;
+	uint32_t settle_ms_ = 150;
+	bool resizing_ = false;
+	bool scaled_ = false;
+	bool enabled_ = true;
+};
+
+inline bool EventPointerPos(const SDL_Event &_event, SDL_FPoint &_pos)
+{
+	switch (_event.type)
+	{
+	case SDL_EVENT_MOUSE_MOTION:
+		_pos = {_event.motion.x, _event.motion.y};
+		return true;
+	case SDL_EVENT_MOUSE_BUTTON_DOWN:
+	case SDL_EVENT_MOUSE_BUTTON_UP:
+		_pos = {_event.button.x, _event.button.y};
+		return true;
+	case SDL_EVENT_MOUSE_WHEEL:
+		_pos = {_event.wheel.mouse_x, _event.wheel.mouse_y};
+		return true;
+	case SDL_EVENT_FINGER_DOWN:
+	case SDL_EVENT_FINGER_UP:
+	case SDL_EVENT_FINGER_MOTION:
+	case SDL_EVENT_FINGER_CANCELED:
+		_pos = {_event.tfinger.x * DisplayInfo::Get().RenderW, _event.tfinger.y * DisplayInfo::Get().RenderH};
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Converts pointer events to window pixels once and feeds them to the
+	gesture recogniser. The mouse (left button) and every finger are tracked
+	as separate pointers; touch/mouse events synthesised by SDL from the other
+	device are skipped so a touch isn't seen twice. Velocities come from the
+	event timestamps, not from when the frame got around to handling them.
+	*/
+class InputStage
+{
+public:
+	static InputStage &Get()
+	{
+		static InputStage instance;
+		return instance;
+	}
+
+	InputStage(const InputStage &) = delete;
+	InputStage(InputStage &&) = delete;
+
+	static constexpr Uint64 MousePointerBit = 1ull << 63;
+
+	InputStage &setConfig(const Gesture::Config &_config)
+	{
+		recognizer_.setConfig(_config);
+		return *this;
+	}
+
+	const Gesture::Recognizer &recognizer() const
+	{
+		return recognizer_;
+	}
+
+	// gui thread only, called for every event before it is dispatched
+	bool process(const SDL_Event &_event)
+	{
+		Gesture::Sample sample;
+		sample.t_ns = _event.common.timestamp;
+		switch (_event.type)
+		{
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+			if (_event.button.which == SDL_TOUCH_MOUSEID or _event.button.button != SDL_BUTTON_LEFT)
+				return false;
+			mouse_down_ = _event.type == SDL_EVENT_MOUSE_BUTTON_DOWN;
+			sample.pointer_id = MousePointerBit | _event.button.which;
+			sample.phase = mouse_down_ ? Gesture::Phase::Down : Gesture::Phase::Up;
+			break;
+		case SDL_EVENT_MOUSE_MOTION:
+			if (_event.motion.which == SDL_TOUCH_MOUSEID or not mouse_down_)
+				return false;
+			sample.pointer_id = MousePointerBit | _event.motion.which;
+			sample.phase = Gesture::Phase::Move;
+			break;
+		case SDL_EVENT_FINGER_DOWN:
+		case SDL_EVENT_FINGER_UP:
+		case SDL_EVENT_FINGER_MOTION:
+		case SDL_EVENT_FINGER_CANCELED:
+			if (_event.tfinger.touchID == SDL_MOUSE_TOUCHID)
+				return false;
+			sample.pointer_id = _event.tfinger.fingerID & ~MousePointerBit;
+			sample.phase = _event.type == SDL_EVENT_FINGER_DOWN	 ? Gesture::Phase::Down
+						   : _event.type == SDL_EVENT_FINGER_UP	 ? Gesture::Phase::Up
+						   : _event.type == SDL_EVENT_FINGER_MOTION ? Gesture::Phase::Move
+																	: Gesture::Phase::Cancel;
+			break;
+		default:
+			return false;
+		}
+		SDL_FPoint pos;
+		EventPointerPos(_event, pos);
+		sample.x = pos.x, sample.y = pos.y;
+		pointer_id_ = sample.pointer_id;
+		pointer_pos_ = pos;
+		recognizer_.feed(sample, gestures_);
+		// the loop sleeps until the next event, make sure it wakes for the long press
+		if (sample.phase == Gesture::Phase::Down)
+			Async::TimerService::Get().setTimeout(
+				static_cast<uint32_t>(recognizer_.config().long_press_ns / 1000000) + 1, [] {});
+		return true;
+	}
+
+	// fires time based gestures, once per frame
+	void tick()
+	{
+		recognizer_.tick(SDL_GetTicksNS(), gestures_);
+	}
 
-	template <typename T>
-	constexpr inline T dpToPx(const T &dp) const
+	// gestures recognised since the last call, in order; valid until the
+	// next call. The two buffers trade places and keep their capacity.
+	const std::vector<Gesture::Event> &takeGestures()
 	{
-		return (DDPI * dp) / 160.f;
+		taken_.clear();
+		taken_.swap(gestures_);
+		return taken_;
 	}
 
-	float RenderH, RenderW, DPRenderH, DPRenderW, DDPI, H_DPI, V_DPI, V_DPI_R, H_DPI_R;
-	float OldRenderH, OldRenderW;
-	int DrawableH, DrawableW;
-	int maxTextureWidth, maxTextureHeight;
-	SDL_DisplayMode mode;
-	DeviceDisplayType display_type;
+	// pointer of the last processed pointer event, in window pixels
+	Uint64 pointerId() const { return pointer_id_; }
+	SDL_FPoint pointerPos() const { return pointer_pos_; }
 
-private:
-	DisplayInfo()
+	// px/s of the last processed pointer; on its up event the release velocity
+	SDL_FPoint velocity() const
 	{
-		display_type = DeviceDisplayType::Unknown;
-		DrawableH = 0, DrawableW = 0;
-		RenderH = RenderW = DPRenderH = DPRenderW = DDPI = H_DPI = V_DPI = V_DPI_R = H_DPI_R = 1.f;
+		if (auto v = recognizer_.velocity(pointer_id_))
+			return {v->first, v->second};
+		return {0.f, 0.f};
 	}
+
+private:
+	InputStage() = default;
+
+	Gesture::Recognizer recognizer_;
+	std::vector<Gesture::Event> gestures_, taken_;
+	Uint64 pointer_id_ = 0;
+	SDL_FPoint pointer_pos_{0.f, 0.f};
+	bool mouse_down_ = false;
 };
 
+#include "SpriteAtlas.hpp"
+
 class Application : protected Context, public IView
 {
 public:
@@ -1847,6 +4158,11 @@ public:
 		bool mouse_touch_events = true;
 		std::string logs_dir = "";
 		float toast_ft_size = 2.5f;// px
+		PERFOMANCE_MODE perf_mode = PERFOMANCE_MODE::NORMAL;
+		// offscreen video driver + software renderer, vsync off; CI/benchmarks without a display or GPU
+		bool headless = false;
+		// with init_everyting, audio and gamepad come up after the first present (haptics always open on first use)
+		bool defer_subsystems = true;
 	};
 
 public:
@@ -1870,7 +4186,6 @@ public:
 	bool quit = false;
 	bool show_fps = false;
 	std::ofstream file;
-	std::ofstream out_app_props_file;
 	Config cfg;
 	ToastManager toast_mgr{};
 
@@ -1883,64 +4198,59 @@ public:
 public:
 	short create(Application::Config config)
 	{
+		StartupTimeline::Get().begin();
 		cfg = config;
 		// check for non existing file
 		if (not config.logs_dir.empty() and not std::filesystem::exists(config.logs_dir)) {
 			config.logs_dir = "";	
 		}
 
-		file.open(config.logs_dir+config.title + "_logs.txt", std::ios::out | std::ios::app);
-		if (file.is_open())
-		{
-			file << "\n\n\n\n----------NEW LOGGING SESSION----------\n";
-		}
+		// the log file and the props file don't need SDL, they are read while
+		// SDL and the window come up; log lines before that are held back
+		auto startup_io = std::async(std::launch::async, [this, log_path = config.logs_dir + config.title + "_logs.txt",
+														  props_path = config.title + "_props.txt"]
+									 {
+			StartupTimeline::Scope step("log file + props");
+			file.open(log_path, std::ios::out | std::ios::app);
+			if (file.is_open())
+			{
+				file << "\n\n\n\n----------NEW LOGGING SESSION----------\n";
+			}
+			return settings_.load(props_path); });
 		GLogger.onLog([this](std::string slog)
 					  {
 			SDL_Log("%s", slog.c_str());
-			if (file.is_open())
+			// Logger calls this after dropping its own lock, from any thread
+			std::lock_guard<std::mutex> lock(log_file_mutex_);
+			if (not log_file_ready_.load(std::memory_order_acquire))
+				early_log_.push_back(std::move(slog));
+			else if (file.is_open())
 			{
 				file << slog << "\n";
 			} });
 		GLogger.Log(Logger::Level::Info, "sys std::thread::hardware_concurrency:",std::to_string(std::thread::hardware_concurrency()));
 
-		int wnx = -1, wny=-1;
-		if (std::filesystem::exists(config.title + "_props.txt")) {
-			std::ifstream app_props_file;
-			std::string line;
-			app_props_file.open(config.title + "_props.txt", std::ios::in);
-			if (!app_props_file.is_open())
-			{
-				GLogger.Log(Logger::Level::Error, "Failed to open file:", config.title + "_props.txt");
-				return false;
-			}
-			while (std::getline(app_props_file, line))
+		if (config.mouse_touch_events)
+			SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS, "1");
+		if (config.headless)
+		{
+			SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+			if (not SDL_Init(SDL_INIT_VIDEO))
 			{
-				std::stringstream ss(line);
-				std::string segment;
-				std::vector<std::string> values;
-
-				while (std::getline(ss, segment, ':'))
-				{
-					values.push_back(segment);
-				}
-				if (values.size() >= 1)
-				{
-					if (values[0] == "winpos")
-					{
-						wnx = std::atoi(values[1].c_str());
-						wny = std::atoi(values[2].c_str());
-
-					}
-				}
+				GLogger.Log(Logger::Level::Error, "headless SDL_Init failed:", std::string(SDL_GetError()));
+				return 0;
 			}
 		}
-		
-		if (config.mouse_touch_events)
-			SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS, "1");
-		if (config.init_everyting)
-			SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD | SDL_INIT_HAPTIC);
+		else if (config.init_everyting)
+		{
+			StartupTimeline::Scope step("SDL_Init");
+			SDL_Init(config.defer_subsystems ? SDL_INIT_VIDEO : SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMEPAD);
+		}
 		if (config.init_ttf)
+		{
+			StartupTimeline::Scope step("TTF_Init");
 			TTF_Init();
+		}
 
 		int displayCount = 0;
 		// 2. Fetch the array of all connected display IDs
@@ -1985,7 +4295,10 @@ public:
 		SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_FLAGS_NUMBER, config.window_flags);
 
 		// 6. Build the centralized window
-		window = SDL_CreateWindowWithProperties(props);
+		{
+			StartupTimeline::Scope step("window");
+			window = SDL_CreateWindowWithProperties(props);
+		}
 
 		// 7. Free properties mapping lookup table immediately 
 		SDL_DestroyProperties(props);
@@ -1998,7 +4311,12 @@ public:
 #else
 		SDL_SetHint(SDL_HINT_RENDER_DRIVER, "opengl");
 #endif
-		renderer = SDL_CreateRenderer(window, nullptr);
+		if (config.headless)
+			SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+		{
+			StartupTimeline::Scope step("renderer");
+			renderer = SDL_CreateRenderer(window, nullptr);
+		}
 		//renderer = SDL_CreateGPURenderer(NULL, window);
 		//gpu_device = SDL_GetGPURendererDevice(renderer);
 		DisplayInfo::Get().setContext(this);
@@ -2017,20 +4335,48 @@ public:
 //  SDL_SetHint(SDL_HINT_RENDER_LINE_METHOD, "3");
 #endif
 		SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
-		if (wnx > -1) {
-			SDL_SetWindowPosition(window, wnx, wny);
+		const bool settings_ok = startup_io.get();
+		{
+			std::lock_guard<std::mutex> lock(log_file_mutex_);
+			if (file.is_open())
+			{
+				for (const auto &slog : early_log_)
+					file << slog << "\n";
+			}
+			early_log_.clear();
+			log_file_ready_.store(true, std::memory_order_release);
+		}
+		if (not settings_ok) {
+			GLogger.Log(Logger::Level::Error, "Failed to open file:", config.title + "_props.txt");
+			return false;
+		}
+		if (settings_.contains("window.x")) {
+			SDL_SetWindowPosition(window, (int)settings_.getInt("window.x"), (int)settings_.getInt("window.y"));
 		}
 
 		adaptiveVsync = &adaptiveVsync_;
 		event = &event_;
-		haptics_.create();
+		// the device is opened on the first play_effect()
 		haptics = &haptics_;
 		RedrawTriggeredEvent = &RedrawTriggeredEvent_;
-		RedrawTriggeredEvent->type = SDL_RegisterEvents(1);
+		RedrawTriggeredEvent->type = WakeEventType();
 		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 		DisplayInfo::Get().setContext(this);
+		{
+			const SDL_DisplayMode *dm = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+			FramePacer::Get().attach(renderer, nullptr != dm ? dm->refresh_rate : 0.f).setMode(config.perf_mode);
+			if (config.headless)
+				FramePacer::Get().setVsyncEnabled(false);
+		}
 
 		CharstoreManager::Get().init(getContext());
+		{
+			StartupTimeline::Scope step("sprite atlas");
+			SpriteAtlas::Get().init(getContext());
+		}
+		Async::TimerService::Get().bindToCurrentThread();
+		Async::TimerService::Get().setWakeHook(WakeGui);
+		Volt::FrameArena::Get().bindToCurrentThread();
 
 		FontAttributes tst_ft{};
 		tst_ft.font_size = IView::to_cust(config.toast_ft_size, bounds.h);
@@ -2043,8 +4389,6 @@ public:
 			GLogger.Log(Logger::Level::Info, "PrefPath:" + PrefPath);
 			*/
 
-		buildLogTextArea();
-
 		return 1;
 	}
 
@@ -2060,24 +4404,12 @@ public:
 		{
 		case EVT_QUIT:
 			quit = true;
+			settings_.flush();
 			break;
 		case SDL_EVENT_WINDOW_MOVED:
-		{
-			out_app_props_file.open(cfg.title + "_props.txt", std::ios::out);
-			if (out_app_props_file.is_open())
-			{
-				// Option A: Extract coordinates directly from the SDL3 event payload (Fastest)
-				int wx = (int)event->window.data1;
-				int wy = (int)event->window.data2;
-
-				// Option B: Or use the classic getter function (it now returns a clean bool)
-				// SDL_GetWindowPosition(window, &wx, &wy);
-
-				out_app_props_file << "winpos:" << wx << ":" << wy;
-			}
-			out_app_props_file.close();
+			// memory only, the store writes it out once the drag has settled
+			settings_.set("window.x", event->window.data1).set("window.y", event->window.data2);
 			break;
-		}
 
 		/*case SDL_KEYDOWN:
 			quit = true;
@@ -2096,6 +4428,49 @@ public:
 		return fps;
 	}
 
+	// writes every input/window event from now on to _path, see EventRecorder
+	bool startRecording(const std::string &_path)
+	{
+		if (not recorder_.open(_path))
+			return false;
+		EventBatch::Get().setRecorder(&recorder_);
+		return true;
+	}
+
+	void stopRecording()
+	{
+		EventBatch::Get().setRecorder(nullptr);
+		recorder_.close();
+	}
+
+	// Replays a recording in place of live input. The frame-time report is
+	// logged when it runs out and handed to _on_done, the app quits
+	// afterwards when _quit_when_done is set.
+	bool startReplay(const std::string &_path, EventReplayer::Speed _speed = EventReplayer::Speed::RealTime,
+					 std::function<void(const EventReplayer::Report &)> _on_done = nullptr, bool _quit_when_done = false)
+	{
+		if (not replayer_.open(_path, _speed))
+			return false;
+		replayer_.setOnFinished([this, _on_done, _quit_when_done](const EventReplayer::Report &_report)
+								{
+			GLogger.Log(Logger::Level::Info, _report.summary());
+			if (_on_done)
+				_on_done(_report);
+			if (_quit_when_done)
+				quit = true; });
+		EventBatch::Get().setReplayer(&replayer_);
+		WakeGui();
+		return true;
+	}
+
+	bool isReplaying() const
+	{
+		return replayer_.isActive();
+	}
+
+	// persisted in <title>_props.txt, written in the background after changes settle
+	Volt::SettingsStore &settings() { return settings_; }
+
 	void showToast(std::string message, uint64_t duration = 3000, SDL_Color bg_col = { 255,255,255,205 }, SDL_Color txt_col = { 0,0,0,255 }, float corner_radius = 25.f) {
 		toast_mgr.addToast(message, duration, bg_col, txt_col, corner_radius);
 		WakeGui();
@@ -2103,7 +4478,12 @@ public:
 
 	~Application()
 	{
-        file.close();
+		EventBatch::Get().setRecorder(nullptr).setReplayer(nullptr);
+		{
+			std::lock_guard<std::mutex> lock(log_file_mutex_);
+			file.close();
+		}
+		SpriteAtlas::Get().reset();
 		SDL_DestroyRenderer(renderer);
 		SDL_DestroyWindow(window);
 		renderer = nullptr;
@@ -2114,27 +4494,147 @@ public:
 private:
 	void buildLogTextArea();
 
+	void dispatch(const SDL_Event &_ev)
+	{
+		*event = _ev;
+		EventBatch::Get().setCurrent(event);
+		InputStage::Get().process(_ev);
+		LatencyTracker::Get().onDispatch(_ev, EventBatch::Get().frame());
+		Application::handleEvent();
+		this->handleEvent();
+	}
+
+	EventRecorder recorder_;
+	EventReplayer replayer_;
+
+#ifdef VOLT_PROFILE
+	// frame-time graph in the bottom left corner, one bar per frame,
+	// green under budget, amber under twice the budget, red above
+	void drawProfilerOverlay()
+	{
+		auto &prof = Profiler::Get();
+		const auto times = prof.frameTimes();
+		const float budget = prof.getFrameBudgetMs();
+		const float scale_ms = budget * 3.f;
+		const float bar_w = 2.f;
+		const float gh = 96.f;
+		const float gw = bar_w * Profiler::FrameHistory;
+		const SDL_FRect bg = {8.f, DisplayInfo::Get().RenderH - gh - 8.f, gw, gh};
+
+		std::vector<SDL_FRect> ok, slow, missed;
+		for (size_t i = 0; i < times.size(); ++i)
+		{
+			const float bh = std::min(times[i] / scale_ms, 1.f) * gh;
+			const SDL_FRect bar = {bg.x + i * bar_w, bg.y + gh - bh, bar_w - 0.5f, bh};
+			if (times[i] <= budget)
+				ok.push_back(bar);
+			else if (times[i] <= budget * 2.f)
+				slow.push_back(bar);
+			else
+				missed.push_back(bar);
+		}
+
+		SDL_BlendMode prev_blend;
+		SDL_GetRenderDrawBlendMode(renderer, &prev_blend);
+		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+		SDL_RenderFillRect(renderer, &bg);
+		SDL_SetRenderDrawColor(renderer, 80, 200, 120, 255);
+		SDL_RenderFillRects(renderer, ok.data(), static_cast<int>(ok.size()));
+		SDL_SetRenderDrawColor(renderer, 240, 180, 40, 255);
+		SDL_RenderFillRects(renderer, slow.data(), static_cast<int>(slow.size()));
+		SDL_SetRenderDrawColor(renderer, 230, 60, 60, 255);
+		SDL_RenderFillRects(renderer, missed.data(), static_cast<int>(missed.size()));
+		// budget line
+		const float by = bg.y + gh - (budget / scale_ms) * gh;
+		SDL_SetRenderDrawColor(renderer, 255, 255, 255, 140);
+		SDL_RenderLine(renderer, bg.x, by, bg.x + gw, by);
+		SDL_SetRenderDrawBlendMode(renderer, prev_blend);
+	}
+#endif
+
 	void loop()
 	{
+		VOLT_PROFILE_THREAD("ui");
 		while (not quit)
 		{
 			frames++;
-			if (adaptiveVsync->pollEvent(event) != 0)
+			auto &batch = EventBatch::Get();
+			auto &timers = Async::TimerService::Get();
+			const bool has_event = batch.drain(*adaptiveVsync, timers.msUntilNext()) != 0;
+			// one timestamp for every animation, toast and timer of this frame
+			Volt::Clock::Get().tick();
+			VOLT_PROFILE_FRAME_BEGIN();
+			{
+				VOLT_PROFILE_SCOPE("timers");
+				timers.fireDue();
+			}
+			{
+				VOLT_PROFILE_SCOPE("ui tasks");
+				UiTaskQueue::Get().drain(UiTaskQueue::Get().frameBudgetNs());
+			}
+			auto &input = InputStage::Get();
+			auto &resize = ResizeCoordinator::Get();
+			if (has_event)
+			{
+				VOLT_PROFILE_SCOPE("handleEvent");
+				for (const auto &ev : batch.events())
+				{
+					if (resize.intercept(ev))
+						continue;
+					dispatch(ev);
+					if (quit)
+						break;
+				}
+			}
+			for (auto settled = resize.takeSettled(); settled and not quit; settled = resize.takeSettled())
+			{
+				VOLT_PROFILE_SCOPE("resize");
+				dispatch(*settled);
+			}
+			batch.setCurrent(nullptr);
+			input.tick();
+			if (not quit)
 			{
-				Application::handleEvent();
-				this->handleEvent();
+				VOLT_PROFILE_SCOPE("gestures");
+				for (const auto &gesture : input.takeGestures())
+					if (not this->onGesture(gesture))
+						ViewTree::dispatchGesture(gesture);
 			}
 			if (not skipFrame)
 			{
-				onUpdate();
-				this->draw();
-				toast_mgr.draw();
+				{
+					VOLT_PROFILE_SCOPE("onUpdate");
+					onUpdate();
+				}
+				resize.applyInterimScale(renderer, window);
+				{
+					VOLT_PROFILE_SCOPE("draw");
+					this->draw();
+					toast_mgr.draw();
+				}
 				/*[[unlikely]] if (nullptr != log_text_area) {
 					log_text_area->draw();
 				}*/
-				SDL_RenderPresent(renderer);
+#ifdef VOLT_PROFILE
+				if (Profiler::Get().isOverlayVisible())
+					drawProfilerOverlay();
+#endif
+				if (LatencyTracker::Get().isOverlayVisible())
+					LatencyTracker::Get().drawOverlay(renderer);
+				{
+					VOLT_PROFILE_SCOPE("SDL_RenderPresent");
+					SDL_RenderPresent(renderer);
+				}
+				LatencyTracker::Get().onPresent();
+				[[unlikely]] if (not StartupTimeline::Get().hasPresented())
+					finishStartup();
+				VOLT_PROFILE_FRAME_END();
+				FramePacer::Get().endFrame(adaptiveVsync->hasRequests());
 			}
 			skipFrame = false;
+			// frame scratch memory is gone from here on
+			Volt::FrameArena::Get().endFrame();
 			tmNowFrame = SDL_GetTicks();
 			if (tmNowFrame >= tmPrevFrame + 1000)
 			{
@@ -2146,6 +4646,20 @@ private:
 	}
 
 private:
+	// runs right after the first present, for whatever the first frame doesn't need
+	void finishStartup()
+	{
+		auto &timeline = StartupTimeline::Get();
+		timeline.onPresent();
+		if (cfg.init_everyting and cfg.defer_subsystems and not cfg.headless)
+		{
+			StartupTimeline::Scope step("audio + gamepad (after first present)");
+			SDL_InitSubSystem(SDL_INIT_AUDIO | SDL_INIT_GAMEPAD);
+		}
+		timeline.finish();
+	}
+
+	Volt::SettingsStore settings_;
 	Haptics haptics_;
 	SDL_Event event_;
 	uint32_t tmPrevFrame = 0;
@@ -2153,6 +4667,10 @@ private:
 	uint32_t frames = 0;
 	uint32_t fps = 0;
 	TextArea *log_text_area = nullptr;
+	// guards file and early_log_ against logging from worker threads
+	std::mutex log_file_mutex_;
+	std::atomic<bool> log_file_ready_{false};
+	std::vector<std::string> early_log_;
 };
 
 
@@ -2423,6 +4941,183 @@ static SDL_Texture *loadImage(SDL_Renderer *renderer, const char *path)
 	return texture;
 }
 
+/**
+ * Box filtered downscale pyramid.
+ * level 0 is the source image, every following level halves the previous one.
+ * levels are only generated while they stay at least as large as the requested size,
+ * so the last level is always the smallest one that still covers the destination.
+ * safe to build on a worker thread, it only touches SDL_Surface memory.
+ */
+class MipChain
+{
+public:
+	MipChain() = default;
+	MipChain(const MipChain &) = delete;
+	MipChain &operator=(const MipChain &) = delete;
+	MipChain(MipChain &&other) noexcept : levels_(std::move(other.levels_)) { other.levels_.clear(); }
+	MipChain &operator=(MipChain &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			levels_ = std::move(other.levels_);
+			other.levels_.clear();
+		}
+		return *this;
+	}
+
+	~MipChain()
+	{
+		reset();
+	}
+
+	// takes ownership of _src
+	static MipChain Build(SDL_Surface *_src, int _min_w, int _min_h)
+	{
+		MipChain chain;
+		if (_src == nullptr)
+			return chain;
+		chain.levels_.push_back(_src);
+		_min_w = std::max(_min_w, 1);
+		_min_h = std::max(_min_h, 1);
+		while (chain.levels_.back()->w / 2 >= _min_w and chain.levels_.back()->h / 2 >= _min_h)
+		{
+			SDL_Surface *next = halve(chain.levels_.back());
+			if (next == nullptr)
+				break;
+			chain.levels_.push_back(next);
+		}
+		return chain;
+	}
+
+	std::size_t size() const noexcept { return levels_.size(); }
+
+	bool empty() const noexcept { return levels_.empty(); }
+
+	SDL_Surface *level(std::size_t _level) const { return levels_[_level]; }
+
+	// smallest level whose size is at least _dst_w x _dst_h, level 0 if none is large enough
+	std::size_t selectLevel(int _dst_w, int _dst_h) const noexcept
+	{
+		std::size_t selected = 0;
+		for (std::size_t i = 0; i < levels_.size(); ++i)
+		{
+			if (levels_[i]->w >= _dst_w and levels_[i]->h >= _dst_h)
+				selected = i;
+			else
+				break;
+		}
+		return selected;
+	}
+
+	// detaches _level from the chain and frees every other level
+	SDL_Surface *release(std::size_t _level)
+	{
+		if (_level >= levels_.size())
+			return nullptr;
+		SDL_Surface *kept = levels_[_level];
+		levels_[_level] = nullptr;
+		reset();
+		return kept;
+	}
+
+	void reset()
+	{
+		for (auto *lvl : levels_)
+			if (lvl != nullptr)
+				SDL_DestroySurface(lvl);
+		levels_.clear();
+	}
+
+private:
+	// 2x2 box filter. colour is weighted by alpha so transparent texels don't darken the edges
+	static SDL_Surface *halve(SDL_Surface *_src)
+	{
+		SDL_Surface *src = _src;
+		if (_src->format != SDL_PIXELFORMAT_RGBA32)
+		{
+			src = SDL_ConvertSurface(_src, SDL_PIXELFORMAT_RGBA32);
+			if (src == nullptr)
+			{
+				SDL_Log("MipChain: couldn't convert surface: %s", SDL_GetError());
+				return nullptr;
+			}
+		}
+		const int sw = src->w, sh = src->h;
+		const int dw = std::max(sw / 2, 1), dh = std::max(sh / 2, 1);
+		SDL_Surface *dst = SDL_CreateSurface(dw, dh, SDL_PIXELFORMAT_RGBA32);
+		if (dst == nullptr)
+		{
+			SDL_Log("MipChain: couldn't create level: %s", SDL_GetError());
+			if (src != _src)
+				SDL_DestroySurface(src);
+			return nullptr;
+		}
+		SDL_LockSurface(src);
+		SDL_LockSurface(dst);
+		for (int y = 0; y < dh; ++y)
+		{
+			const int y0 = std::min(y * 2, sh - 1), y1 = std::min(y * 2 + 1, sh - 1);
+			const auto *row0 = static_cast<const uint8_t *>(src->pixels) + (y0 * src->pitch);
+			const auto *row1 = static_cast<const uint8_t *>(src->pixels) + (y1 * src->pitch);
+			auto *out = static_cast<uint8_t *>(dst->pixels) + (y * dst->pitch);
+			for (int x = 0; x < dw; ++x)
+			{
+				const int x0 = std::min(x * 2, sw - 1) * 4, x1 = std::min(x * 2 + 1, sw - 1) * 4;
+				const uint8_t *px[4] = {row0 + x0, row0 + x1, row1 + x0, row1 + x1};
+				uint32_t r = 0, g = 0, b = 0, a = 0;
+				for (auto *p : px)
+				{
+					r += p[0] * p[3], g += p[1] * p[3], b += p[2] * p[3];
+					a += p[3];
+				}
+				if (a > 0)
+				{
+					out[x * 4 + 0] = static_cast<uint8_t>(r / a);
+					out[x * 4 + 1] = static_cast<uint8_t>(g / a);
+					out[x * 4 + 2] = static_cast<uint8_t>(b / a);
+				}
+				else
+				{
+					out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = 0;
+				}
+				out[x * 4 + 3] = static_cast<uint8_t>(a / 4);
+			}
+		}
+		SDL_UnlockSurface(dst);
+		SDL_UnlockSurface(src);
+		if (src != _src)
+			SDL_DestroySurface(src);
+		return dst;
+	}
+
+private:
+	std::vector<SDL_Surface *> levels_;
+};
+
+/**
+ * Replaces _src (ownership is taken) with the smallest mip level that still covers
+ * _dst_w x _dst_h. with _keep_aspect the destination is the aspect-fitted size inside the box.
+ * returns _src untouched if it is already small enough.
+ */
+SDL_Surface *DownscaleSurfaceToFit(SDL_Surface *_src, int _dst_w, int _dst_h, bool _keep_aspect = false)
+{
+	if (_src == nullptr or _dst_w <= 0 or _dst_h <= 0)
+		return _src;
+	if (_keep_aspect)
+	{
+		const float scale = std::min((float)_dst_w / (float)_src->w, (float)_dst_h / (float)_src->h);
+		if (scale >= 1.f)
+			return _src;
+		_dst_w = (int)std::ceil((float)_src->w * scale);
+		_dst_h = (int)std::ceil((float)_src->h * scale);
+	}
+	if (_src->w / 2 < _dst_w or _src->h / 2 < _dst_h)
+		return _src;
+	auto chain = MipChain::Build(_src, _dst_w, _dst_h);
+	return chain.release(chain.selectLevel(_dst_w, _dst_h));
+}
+
 enum class QUADRANT : uint8_t
 {
 	TOP_LEFT,
@@ -4576,6 +7271,7 @@ public:
 		bounds.x += dx, bounds.y += dy;
 		rect.x += dx, rect.y += dy;
 		inner_rect.x += dx, inner_rect.y += dy;
+		markGeometryDirty();
 	};
 };
 
@@ -4589,7 +7285,7 @@ public:
 		MAX_LEN = 100.f * ((vO * vO) / (2.f * std::fabs(ADG)));
 		value = 0.f, prev_dy = 0.f;
 		update_physics = true;
-		tm_start = SDL_GetTicks();
+		tm_start = Volt::Clock::Get().nowMs();
 		return *this;
 	}
 
@@ -4602,7 +7298,7 @@ public:
 		MAX_LEN = max_length;
 		value = 0.f, prev_dy = 0.f;
 		update_physics = true;
-		tm_start = SDL_GetTicks();
+		tm_start = Volt::Clock::Get().nowMs();
 		return *this;
 	}
 
@@ -4610,7 +7306,7 @@ public:
 	{
 		if (!update_physics)
 			return *this;
-		float t = (SDL_GetTicks() - tm_start) / 1000.f;
+		float t = (Volt::Clock::Get().nowMs() - tm_start) / 1000.f;
 		// t *= 1.5f;
 
 		dy = ((vO * t) + ((0.5f * ADG) * (t * t))) * 100.f;
@@ -4688,7 +7384,7 @@ class DecelerateInterpolator
 		distance = 100.f * ((vo * vo) / (2 * std::fabs(adg)));
 		value = 0.f, prev_dy = 0.f;
 		update_physics = true;
-		tm_start = SDL_GetTicks();
+		tm_start = Volt::Clock::Get().nowMs();
 		return *this;
 	}
 
@@ -4700,7 +7396,7 @@ class DecelerateInterpolator
 		distance = max_distance;
 		value = 0.f, prev_dy = 0.f;
 		update_physics = true;
-		tm_start = SDL_GetTicks();
+		tm_start = Volt::Clock::Get().nowMs();
 		return *this;
 	}
 
@@ -4709,7 +7405,7 @@ class DecelerateInterpolator
 	{
 		if (!update_physics)
 			return *this;
-		float t = (SDL_GetTicks() - tm_start) / 1000.f;
+		float t = (Volt::Clock::Get().nowMs() - tm_start) / 1000.f;
 		// t *= 1.5f;
 
 		dy = ((vo * t) + ((0.5f * adg) * (t * t))) * 100.f;
@@ -4800,7 +7496,7 @@ public:
 		Gravity gravity = Gravity::Left;
 		bool overflow = false;
 		uint32_t max_lines = 0; // 0 means infinite lines
-		std::function<bool(TextArea&)> onClick = nullptr;
+		Volt::InplaceFunction<bool(TextArea&)> onClick = nullptr;
 	};
 
 public:
@@ -4811,6 +7507,8 @@ public:
 		attr = _attr;
 		initial_attr = _attr;
 		bounds = attr.bounds;
+		markGeometryDirty();
+		updateEventMask();
 
 		final_txt_area.x = to_cust(attr.margin.left, bounds.w);
 		final_txt_area.y = to_cust(attr.margin.top, bounds.h);
@@ -4850,6 +7548,7 @@ public:
 				next_w > 0.f && next_h > 0.f) {
 
 				bounds = { next_x, next_y, next_w, next_h };
+				markGeometryDirty();
 
 				final_txt_area.x = to_cust(attr.margin.left, bounds.w);
 				final_txt_area.y = to_cust(attr.margin.top, bounds.h);
@@ -4925,8 +7624,14 @@ public:
 		genTextTexture();
 	}
 
-	void setOnClick(std::function<bool(TextArea&)> onClick) {
+	void setOnClick(Volt::InplaceFunction<bool(TextArea&)> onClick) {
 		attr.onClick = std::move(onClick);
+		updateEventMask();
+	}
+
+	// a label only needs resizes and render resets, pointers once it's clickable
+	void updateEventMask() {
+		subscribeEvents(EVC_WINDOW | EVC_RENDER_RESET | (attr.onClick ? EVC_POINTER : EVC_NONE));
 	}
 
 	const std::string& getText() const {
@@ -4938,6 +7643,7 @@ public:
 	TextArea& resize(float w, float h) {
 		attr.bounds.w = w, attr.bounds.h = h;
 		bounds.w = w, bounds.h = h;
+		markGeometryDirty();
 
 		final_txt_area.x = to_cust(attr.margin.left, bounds.w);
 		final_txt_area.y = to_cust(attr.margin.top, bounds.h);
@@ -5277,6 +7983,7 @@ public:
 		IView::type = "TextCardView";
 		attr = _attr;
 		bounds = _attr.bounds;
+		markGeometryDirty();
 		selected = _selected;
 
 		if (nullptr != texture) {
@@ -5328,6 +8035,8 @@ struct ImageButtonAttributes
 	// inner image box dimensions in percentage {%x,%y,%w,%h} relative to rect
 	SDL_FRect percentage_img_rect = {0.f, 0.f, 100.f, 100.f};
 	std::string image_path;
+	// name of a SpriteAtlas region, used with IMAGE_LD_STYLE::ATLAS_REGION
+	std::string atlas_region;
 	// image loading style
 	IMAGE_LD_STYLE image_load_style = IMAGE_LD_STYLE::NORMAL;
 	SDL_Texture *custom_texture = nullptr;
@@ -5336,6 +8045,8 @@ struct ImageButtonAttributes
 	float corner_radius = 0.f;
 	SDL_Color bg_color = {0x00, 0x00, 0x00, 0x00};
 	float shrink_size = 0.f;
+	// downscale large images through a box filtered mip chain to the smallest level that still covers the image box
+	bool use_mipmaps = true;
 };
 
 class ImageButton : public Context, public IView
@@ -5354,6 +8065,17 @@ public:
 		return *this;
 	}
 
+	/**
+	 * When enabled (default) images larger than the image box are reduced to the smallest
+	 * mip level that still covers it before they are uploaded, the rest of the chain is released.
+	 * must be set before Build
+	 */
+	ImageButton &setUseMipmaps(bool _use_mipmaps)
+	{
+		use_mipmaps_ = _use_mipmaps;
+		return *this;
+	}
+
 	/**
 	 * Add a callback which will be invoked during a on mouse click event
 	 * The callbacks are invoked in the order they were added/registered
@@ -5371,6 +8093,7 @@ public:
 
 	ImageButton &Build(const ImageButtonAttributes &_imageButtonAttributes)
 	{
+		this->setUseMipmaps(_imageButtonAttributes.use_mipmaps);
 		if (_imageButtonAttributes.image_load_style == IMAGE_LD_STYLE::NORMAL)
 		{
 			this->Build(_imageButtonAttributes.image_path, _imageButtonAttributes.rect, _imageButtonAttributes.percentage_img_rect, _imageButtonAttributes.corner_radius, _imageButtonAttributes.bg_color);
@@ -5394,6 +8117,10 @@ public:
 		{
 			this->BuildAsyncWithDefaultTexture(_imageButtonAttributes.getImageSurface, _imageButtonAttributes.custom_texture, _imageButtonAttributes.rect, _imageButtonAttributes.percentage_img_rect, _imageButtonAttributes.corner_radius, _imageButtonAttributes.bg_color);
 		}
+		else if (_imageButtonAttributes.image_load_style == IMAGE_LD_STYLE::ATLAS_REGION)
+		{
+			this->BuildFromAtlas(_imageButtonAttributes.atlas_region, _imageButtonAttributes.rect, _imageButtonAttributes.percentage_img_rect, _imageButtonAttributes.corner_radius, _imageButtonAttributes.bg_color);
+		}
 		this->setShrinkSize(_imageButtonAttributes.shrink_size);
 		this->configureShrinkSize();
 		return *this;
@@ -5402,11 +8129,21 @@ public:
 	ImageButton &Build(const std::string &_img_path, const SDL_FRect &_rect, const SDL_FRect &_percentage_img_rect = {0.f, 0.f, 100.f, 100.f},
 					   const float &_corner_radius = 0.f, const SDL_Color &_bg_color = {0x00, 0x00, 0x00, 0x00})
 	{
-		SDL_Texture *tmp_texture_ = IMG_LoadTexture(renderer, _img_path.c_str());
-		if (not tmp_texture_)
+		SDL_Texture *tmp_texture_ = nullptr;
+		SDL_Surface *tmp_surface_ = IMG_Load(_img_path.c_str());
+		if (not tmp_surface_)
 		{
 			SDL_Log("couldn't load img: %s : %s", _img_path.c_str(), SDL_GetError());
 		}
+		else
+		{
+			// the image is stretched into the image box, so the level must cover it on both axes
+			if (use_mipmaps_)
+				tmp_surface_ = DownscaleSurfaceToFit(tmp_surface_, (int)std::ceil(to_cust(_percentage_img_rect.w, _rect.w)),
+													 (int)std::ceil(to_cust(_percentage_img_rect.h, _rect.h)));
+			tmp_texture_ = SDL_CreateTextureFromSurface(renderer, tmp_surface_);
+			SDL_DestroySurface(tmp_surface_);
+		}
 		build_comon(tmp_texture_, _rect, _percentage_img_rect, _corner_radius, _bg_color);
 		DestroyTextureSafe(tmp_texture_);
 		return *this;
@@ -5419,12 +8156,48 @@ public:
 		return *this;
 	}
 
+	/**
+	 * Uses a region of a packed SpriteAtlas page instead of a private texture.
+	 * without a background or rounded corners nothing is rendered into texture_, the region
+	 * is submitted to the SpriteAtlas batch at draw time so that many icons share one draw call.
+	 */
+	ImageButton &BuildFromAtlas(const std::string &_region_name, const SDL_FRect &_rect, const SDL_FRect &_percentage_img_rect = {0.f, 0.f, 100.f, 100.f},
+								const float &_corner_radius = 0.f, const SDL_Color &_bg_color = {0x00, 0x00, 0x00, 0x00})
+	{
+		auto region = SpriteAtlas::Get().find(_region_name);
+		if (not region)
+		{
+			GLogger.Log(Logger::Level::Error, "ImageButton: atlas region not found:", _region_name);
+			build_comon(nullptr, _rect, _percentage_img_rect, _corner_radius, _bg_color);
+			return *this;
+		}
+		if (_corner_radius > 0.f or _bg_color.a > 0)
+		{
+			build_comon(region->page, _rect, _percentage_img_rect, _corner_radius, _bg_color, &region->src);
+			return *this;
+		}
+		bounds = _rect;
+		markGeometryDirty();
+		subscribeEvents(EVC_POINTER | EVC_WINDOW);
+		corner_radius_ = _corner_radius;
+		bg_color_ = _bg_color;
+		texture_.reset();
+		img_rect_ = {to_cust(_percentage_img_rect.x, _rect.w), to_cust(_percentage_img_rect.y, _rect.h),
+					 to_cust(_percentage_img_rect.w, _rect.w), to_cust(_percentage_img_rect.h, _rect.h)};
+		adjust_image_rect_to_fit((int)region->src.w, (int)region->src.h);
+		// kept relative to bounds so that shrinking and resizing scale the icon with the button
+		atlas_img_frac_ = {img_rect_.x / bounds.w, img_rect_.y / bounds.h, img_rect_.w / bounds.w, img_rect_.h / bounds.h};
+		atlas_region_ = *region;
+		configureShrinkSize();
+		return *this;
+	}
+
 	ImageButton &BuildAsync(const std::string &_img_path, const SDL_FRect &_rect, const SDL_FRect &_percentage_img_rect = {0.f, 0.f, 100.f, 100.f},
 							const float &_corner_radius = 0.f, const SDL_Color &_bg_color = {0x00, 0x00, 0x00, 0x00})
 	{
 		build_with_async_ = true;
 		build_comon(nullptr, _rect, _percentage_img_rect, _corner_radius, _bg_color);
-		async_load_future_ = executor_.enqueue(&ImageButton::async_img_Load, this, _img_path);
+		async_load_future_ = executor_.enqueue(&ImageButton::async_img_Load, this, _img_path, async_dst_w(), async_dst_h());
 		adaptiveVsyncHD.startRedrawSession();
 		return *this;
 	}
@@ -5435,7 +8208,7 @@ public:
 	{
 		build_with_async_ = true;
 		build_comon(nullptr, _rect, _percentage_img_rect, _corner_radius, _bg_color);
-		async_load_future_ = executor_.enqueue(_customSurfaceLoader);
+		async_load_future_ = executor_.enqueue(&ImageButton::async_custom_Load, this, _customSurfaceLoader, async_dst_w(), async_dst_h());
 		adaptiveVsyncHD.startRedrawSession();
 		return *this;
 	}
@@ -5446,7 +8219,7 @@ public:
 	{
 		build_with_async_ = true;
 		build_comon(_custom_texture, _rect, _percentage_img_rect, _corner_radius, _bg_color);
-		async_load_future_ = std::async(std::launch::async, &ImageButton::async_img_Load, this, _img_path);
+		async_load_future_ = std::async(std::launch::async, &ImageButton::async_img_Load, this, _img_path, async_dst_w(), async_dst_h());
 		adaptiveVsyncHD.startRedrawSession();
 		return *this;
 	}
@@ -5458,7 +8231,7 @@ public:
 	{
 		build_with_async_ = true;
 		build_comon(_custom_texture, _rect, _percentage_img_rect, _corner_radius, _bg_color);
-		async_load_future_ = std::async(std::launch::async, _customSurfaceLoader);
+		async_load_future_ = std::async(std::launch::async, &ImageButton::async_custom_Load, this, _customSurfaceLoader, async_dst_w(), async_dst_h());
 		adaptiveVsyncHD.startRedrawSession();
 		return *this;
 	}
@@ -5467,6 +8240,14 @@ public:
 	{
 		[[unlikely]] if (build_with_async_)
 			checkAndProcessAsyncProgress();
+		if (atlas_region_)
+		{
+			SpriteAtlas::Get().submit(*atlas_region_, {bounds.x + (atlas_img_frac_.x * bounds.w), bounds.y + (atlas_img_frac_.y * bounds.h),
+													   atlas_img_frac_.w * bounds.w, atlas_img_frac_.h * bounds.h});
+			return;
+		}
+		// quads queued by atlas buttons drawn before this one go first
+		SpriteAtlas::Get().flush();
 		RenderTexture(renderer, texture_.get(), nullptr, &bounds);
 	}
 
@@ -5562,9 +8343,12 @@ public:
 
 private:
 	void build_comon(SDL_Texture *_texture, const SDL_FRect &_rect, const SDL_FRect &_percentage_img_rect, const float &_corner_radius,
-					 const SDL_Color &_bg_color)
+					 const SDL_Color &_bg_color, const SDL_FRect *_src_rect = nullptr)
 	{
+		atlas_region_.reset();
 		bounds = _rect;
+		markGeometryDirty();
+		subscribeEvents(EVC_POINTER | EVC_WINDOW);
 		img_rect_.x = to_cust(_percentage_img_rect.x, _rect.w);
 		img_rect_.y = to_cust(_percentage_img_rect.y, _rect.h);
 		img_rect_.w = to_cust(_percentage_img_rect.w, _rect.w);
@@ -5587,7 +8371,7 @@ private:
 		SDL_SetRenderTarget(renderer, texture_.get());
 		RenderClear(renderer, 0, 0, 0, 0);
 		fillRoundedRectF(renderer, {0.f, 0.f, bounds.w, bounds.h}, corner_radius_, bg_color_);
-		RenderTexture(renderer, _texture, nullptr, &img_rect_);
+		RenderTexture(renderer, _texture, _src_rect, &img_rect_);
 		cache_r_target.release(renderer);
 		transformToRoundedTexture(renderer, texture_.get(), corner_radius_);
 		configureShrinkSize();
@@ -5717,6 +8501,7 @@ private:
 		bounds.w = final_width;
 		bounds.y += ((bounds.h - final_height) / 2.f);
 		bounds.h = final_height;
+		markGeometryDirty();
 	}
 
 	void shrinkButton() noexcept
@@ -5728,6 +8513,7 @@ private:
 		bounds.w -= shrink_size_ * 2.f;
 		bounds.h -= shrink_size_ * 2.f;
 		shrinked_ = true;
+		markGeometryDirty();
 	}
 
 	void unshrinkButton() noexcept
@@ -5739,6 +8525,7 @@ private:
 		bounds.w += shrink_size_ * 2.f;
 		bounds.h += shrink_size_ * 2.f;
 		shrinked_ = false;
+		markGeometryDirty();
 	}
 
 	void configureShrinkSize() noexcept
@@ -5753,14 +8540,25 @@ private:
 		}
 	}
 
-	SDL_Surface *async_img_Load(const std::string &_path) noexcept
+	SDL_Surface *async_img_Load(const std::string &_path, int _dst_w, int _dst_h) noexcept
 	{
 		SDL_Surface *surface;
 		if (!(surface = IMG_Load(_path.c_str())))
 			SDL_Log("%s", SDL_GetError());
-		return surface;
+		// async images are aspect fitted into the image box (see adjust_image_rect_to_fit)
+		return DownscaleSurfaceToFit(surface, _dst_w, _dst_h, true);
+	}
+
+	SDL_Surface *async_custom_Load(std::function<SDL_Surface *()> _customSurfaceLoader, int _dst_w, int _dst_h) noexcept
+	{
+		SDL_Surface *surface = _customSurfaceLoader ? _customSurfaceLoader() : nullptr;
+		return DownscaleSurfaceToFit(surface, _dst_w, _dst_h, true);
 	}
 
+	// destination size handed to the loader thread, 0 disables the downscale
+	int async_dst_w() const noexcept { return use_mipmaps_ ? (int)std::ceil(img_rect_.w) : 0; }
+	int async_dst_h() const noexcept { return use_mipmaps_ ? (int)std::ceil(img_rect_.h) : 0; }
+
 private:
 	uint32_t async_start;
 	SharedTexture texture_;
@@ -5768,8 +8566,10 @@ private:
 	float corner_radius_ = 0.f;
 	float shrink_size_ = 0.f, shrink_perc_ = 10.f;
 	SDL_Color bg_color_;
+	std::optional<AtlasRegion> atlas_region_;
+	SDL_FRect atlas_img_frac_ = {0.f, 0.f, 1.f, 1.f};
 	bool touch_down_ = false, motion_occured_ = false, shrinked_ = false, build_with_async_ = false;
-	bool enabled = true;
+	bool enabled = true, use_mipmaps_ = true;
 	std::function<void()> onClickedCallBack_ = nullptr;
 	std::shared_future<SDL_Surface *> async_load_future_;
 	std::shared_future<void> async_free1_;
@@ -5778,7 +8578,7 @@ private:
 	AdaptiveVsyncHandler adaptiveVsyncHD;
 };
 
-Async::ThreadPool ImageButton::executor_(1);
+Async::ThreadPool ImageButton::executor_(1, Async::ThreadPool::DeferStart{});
 
 
 	struct PlotTheme {
@@ -5820,6 +8620,8 @@ Async::ThreadPool ImageButton::executor_(1);
 			Context::setContext(_context);
 			attr = _attr;
 			bounds = attr.rect;
+			markGeometryDirty();
+			subscribeEvents(EVC_NONE);
 
 			// Calculate pixel padding based on bounds
 			pixel_padding.left = to_cust(attr.padding.left, bounds.w);
@@ -5860,10 +8662,9 @@ Async::ThreadPool ImageButton::executor_(1);
 			// Simple Cohen-Sutherland-style clip check (optimization)
 			if (!lineVisible(p1, p2)) return;
 
-			render_queue.emplace_back([this, p1, p2, color]() {
-				SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-				SDL_RenderLine(renderer, p1.x, p1.y, p2.x, p2.y);
-				});
+			DrawCmd cmd{ DrawCmd::Kind::Line };
+			cmd.p[0] = p1, cmd.p[1] = p2, cmd.color = color;
+			render_queue.push_back(cmd);
 		}
 
 		void drawRect(double x, double y, double w, double h, SDL_Color color, bool filled = true) {
@@ -5874,11 +8675,9 @@ Async::ThreadPool ImageButton::executor_(1);
 
 			SDL_FRect r = { p1.x, p1.y, p2.x - p1.x, p2.y - p1.y };
 
-			render_queue.emplace_back([this, r, color, filled]() {
-				SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-				if (filled) SDL_RenderFillRect(renderer, &r);
-				else SDL_RenderRect(renderer, &r);
-				});
+			DrawCmd cmd{ DrawCmd::Kind::Rect };
+			cmd.rect = r, cmd.color = color, cmd.filled = filled;
+			render_queue.push_back(cmd);
 		}
 
 		void drawCircle(double x, double y, float radius_px, SDL_Color color, bool filled = true) {
@@ -5887,10 +8686,9 @@ Async::ThreadPool ImageButton::executor_(1);
 			// Check visibility
 			if (center.x + radius_px < inner_bounds.x || center.x - radius_px > inner_bounds.x + inner_bounds.w) return;
 
-			render_queue.emplace_back([this, center, radius_px, color, filled]() {
-				if (filled) FillCircle(renderer, center.x, center.y, radius_px, color);
-				else DrawCircle(renderer, center.x, center.y, radius_px, color);
-				});
+			DrawCmd cmd{ DrawCmd::Kind::Circle };
+			cmd.p[0] = center, cmd.radius = radius_px, cmd.color = color, cmd.filled = filled;
+			render_queue.push_back(cmd);
 		}
 
 		void drawTriangle(double x1, double y1, double x2, double y2, double x3, double y3, SDL_Color color) {
@@ -5898,12 +8696,9 @@ Async::ThreadPool ImageButton::executor_(1);
 			SDL_FPoint p2 = worldToScreen(x2, y2);
 			SDL_FPoint p3 = worldToScreen(x3, y3);
 
-			render_queue.emplace_back([this, p1, p2, p3, color]() {
-				SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-				SDL_RenderLine(renderer, p1.x, p1.y, p2.x, p2.y);
-				SDL_RenderLine(renderer, p2.x, p2.y, p3.x, p3.y);
-				SDL_RenderLine(renderer, p3.x, p3.y, p1.x, p1.y);
-				});
+			DrawCmd cmd{ DrawCmd::Kind::Triangle };
+			cmd.p[0] = p1, cmd.p[1] = p2, cmd.p[2] = p3, cmd.color = color;
+			render_queue.push_back(cmd);
 		}
 
 		// --- IView Implementation ---
@@ -5931,8 +8726,30 @@ Async::ThreadPool ImageButton::executor_(1);
 
 			// 4. Execute Render Queue (Primitives)
 			for (const auto& cmd : render_queue) {
-				cmd();
+				const SDL_Color& c = cmd.color;
+				switch (cmd.kind) {
+				case DrawCmd::Kind::Line:
+					SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+					SDL_RenderLine(renderer, cmd.p[0].x, cmd.p[0].y, cmd.p[1].x, cmd.p[1].y);
+					break;
+				case DrawCmd::Kind::Rect:
+					SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+					if (cmd.filled) SDL_RenderFillRect(renderer, &cmd.rect);
+					else SDL_RenderRect(renderer, &cmd.rect);
+					break;
+				case DrawCmd::Kind::Circle:
+					if (cmd.filled) FillCircle(renderer, cmd.p[0].x, cmd.p[0].y, cmd.radius, c);
+					else DrawCircle(renderer, cmd.p[0].x, cmd.p[0].y, cmd.radius, c);
+					break;
+				case DrawCmd::Kind::Triangle:
+					SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+					SDL_RenderLine(renderer, cmd.p[0].x, cmd.p[0].y, cmd.p[1].x, cmd.p[1].y);
+					SDL_RenderLine(renderer, cmd.p[1].x, cmd.p[1].y, cmd.p[2].x, cmd.p[2].y);
+					SDL_RenderLine(renderer, cmd.p[2].x, cmd.p[2].y, cmd.p[0].x, cmd.p[0].y);
+					break;
+				}
 			}
+			// keeps its capacity, recording the next frame doesn't allocate
 			render_queue.clear();
 
 			// 5. Reset Clip
@@ -5952,8 +8769,18 @@ Async::ThreadPool ImageButton::executor_(1);
 		SDL_FRect inner_bounds;
 		Margin pixel_padding;
 
-		// Command queue for rendering primitives to ensure layering
-		std::vector<std::function<void()>> render_queue;
+		// Command queue for rendering primitives to ensure layering, plain
+		// data instead of std::function so recording a primitive never allocates
+		struct DrawCmd {
+			enum class Kind : uint8_t { Line, Rect, Circle, Triangle };
+			Kind kind = Kind::Line;
+			SDL_FPoint p[3]{};
+			SDL_FRect rect{};
+			float radius = 0.f;
+			SDL_Color color{};
+			bool filled = true;
+		};
+		std::vector<DrawCmd> render_queue;
 
 		// Label Pools (Reusing TextAreas for performance)
 		std::vector<TextArea> x_labels_pool;
@@ -6062,6 +8889,7 @@ Async::ThreadPool ImageButton::executor_(1);
 
 			// Update Bounds directly
 			lbl.bounds = { x, y, w, h };
+			lbl.markGeometryDirty();
 			lbl.setTextAndColor(ss.str(), attr.theme.text_color, { 0,0,0,0 }, { 0,0,0,0 });
 			lbl.show();
 		}
@@ -6087,6 +8915,7 @@ Async::ThreadPool ImageButton::executor_(1);
 			float y = screenY - (h / 2.f);
 
 			lbl.bounds = { x, y, w, h };
+			lbl.markGeometryDirty();
 			lbl.setTextAndColor(ss.str(), attr.theme.text_color, { 0,0,0,0 }, { 0,0,0,0 });
 			lbl.show();
 		}
@@ -6148,6 +8977,8 @@ public:
 		line_skip_ = textboxAttr_.lineSpacing;
 		isButton = textboxAttr_.isButton;
 		bounds = textboxAttr_.rect;
+		markGeometryDirty();
+		updateEventMask();
 		// outlineRect.Build(this, textboxAttr_.rect, textboxAttr_.outline, textboxAttr_.conerRadius, textboxAttr_.textAttributes.bg_color, textboxAttr_.outlineColor);
 
 		text_rect_ = { to_cust(textboxAttr_.margin.x, bounds.w),
@@ -6253,9 +9084,27 @@ public:
 	TextBox& onClick(std::function<bool(TextBox*)> _on_clicked_callback) noexcept
 	{
 		onClickedCallback_ = _on_clicked_callback;
+		updateEventMask();
 		return *this;
 	}
 
+	void linkView(IView *link_view) override
+	{
+		IView::linkView(link_view);
+		updateEventMask();
+	}
+
+	// A plain label only needs resizes and render resets. Pointers once it
+	// is a button, clickable or highlights on hover; a linked view gets
+	// everything passed on.
+	void updateEventMask()
+	{
+		uint32_t mask = EVC_WINDOW | EVC_RENDER_RESET;
+		if (isButton or onClickedCallback_ or config_dat_.highlightOnHover or config_dat_.useHaptics)
+			mask |= EVC_POINTER;
+		subscribeEvents(nullptr != linked_view ? EVC_ALL : mask);
+	}
+
 	constexpr inline TextBox& setConerRadius(const float& cr_) noexcept
 	{
 		this->coner_radius_ = cr_;
@@ -6587,6 +9436,7 @@ private:
 						}
 						bounds.x = bounds.x + (text_rect_.x - final_rad);
 						bounds.w = text_rect_.w + (final_rad * 2.f);
+						markGeometryDirty();
 						outlineRect.rect.x = outlineRect.rect.x + (text_rect_.x - final_rad);
 						outlineRect.rect.w = text_rect_.w + (final_rad * 2.f);
 					}
@@ -6617,6 +9467,7 @@ private:
 				}
 				bounds.x = bounds.x + (text_rect_.x - final_rad);
 				bounds.w = text_rect_.w + (final_rad * 2.f);
+				markGeometryDirty();
 				outlineRect.rect.x = outlineRect.rect.x + (text_rect_.x - final_rad);
 				outlineRect.rect.w = text_rect_.w + (final_rad * 2.f);
 			}
@@ -6650,6 +9501,7 @@ protected:
 	inline void update_pos_internal(const float& x, const float& y, const bool& _is_animated) noexcept
 	{
 		bounds.x += x, bounds.y += y;
+		markGeometryDirty();
 		dest_src_.x += x, dest_src_.y += y;
 		config_dat_.rect.x += x, config_dat_.rect.y += y;
 		outlineRect.rect.x += x, outlineRect.rect.y += y;
@@ -6706,6 +9558,9 @@ public:
 		adaptiveVsyncHD.setAdaptiveVsync(adaptiveVsync);
 		attr = _attr;
 		bounds = _attr.rect;
+		markGeometryDirty();
+		// handles nothing
+		subscribeEvents(EVC_NONE);
 		attr.transition_speed = DisplayInfo::Get().to_cust(_attr.transition_speed, bounds.h);
 		step_tm = (float)attr.speed / bounds.w;
 		texture = CreateSharedTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bounds.w, bounds.h);
@@ -6729,6 +9584,7 @@ public:
 	{
 		bounds.x += _dx;
 		bounds.y += _dy;
+		markGeometryDirty();
 	}
 
 	std::string getText() { return text_; }
@@ -6774,10 +9630,9 @@ public:
 		txt_rect2.x = dst.w + DisplayInfo::Get().to_cust(40.f, bounds.w);
 		cache_txt_rect2_x = txt_rect2.x;
 		crt_.release(renderer);
-		tm_last_pause = SDL_GetTicks();
+		tm_last_pause = Volt::Clock::Get().nowMs();
 		tm_last_update = tm_last_pause; //+attr.pause_duration+1;
-		Async::GThreadPool.enqueue([this]()
-			{SDL_Delay(attr.pause_duration); WakeGui(); });
+		schedulePauseEnd();
 		// adaptiveVsyncHD.startRedrawSession();
 	}
 
@@ -6785,11 +9640,11 @@ public:
 	{
 		if (not is_centered)
 		{
-			const auto now = SDL_GetTicks();
-			if (now - tm_last_pause > attr.pause_duration and not is_running)
+			const auto now = Volt::Clock::Get().nowMs();
+			if (now - tm_last_pause > attr.pause_duration and not is_running and FramePacer::Get().effectsEnabled())
 			{
 				is_running = true;
-				tm_last_update = SDL_GetTicks();
+				tm_last_update = Volt::Clock::Get().nowMs();
 				adaptiveVsyncHD.startRedrawSession();
 			}
 			if (is_running)
@@ -6801,28 +9656,34 @@ public:
 	}
 
 private:
+	// wakes the loop once the pause is over, draw() then starts scrolling
+	void schedulePauseEnd()
+	{
+		Async::TimerService::Get().cancel(pause_timer_);
+		pause_timer_ = Async::TimerService::Get().setTimeout(attr.pause_duration + 1, [] {});
+	}
+
 	void update()
 	{
 		CacheRenderTarget crt_(renderer);
 		SDL_SetRenderTarget(renderer, texture.get());
 		RenderClear(renderer, attr.bg_color.r, attr.bg_color.g, attr.bg_color.b, attr.bg_color.a);
-		const auto df = static_cast<float>(SDL_GetTicks() - tm_last_update);
+		const auto df = static_cast<float>(Volt::Clock::Get().nowMs() - tm_last_update);
 		if (df >= step_tm)
 		{
 			float num_steps = df / (float)step_tm;
 			txt_rect.x -= num_steps;
 			txt_rect2.x -= num_steps;
-			tm_last_update = SDL_GetTicks();
+			tm_last_update = Volt::Clock::Get().nowMs();
 		}
 		if (txt_rect2.x < 0.f)
 		{
 			txt_rect.x = 0.f;
 			txt_rect2.x = cache_txt_rect2_x;
 			is_running = false;
-			tm_last_pause = SDL_GetTicks();
-			tm_last_update = SDL_GetTicks();
-			Async::GThreadPool.enqueue([this]()
-				{SDL_Delay(attr.pause_duration); WakeGui(); });
+			tm_last_pause = Volt::Clock::Get().nowMs();
+			tm_last_update = Volt::Clock::Get().nowMs();
+			schedulePauseEnd();
 			adaptiveVsyncHD.stopRedrawSession();
 		}
 		RenderTexture(renderer, text_texture.get(), nullptr, &txt_rect);
@@ -6843,6 +9704,7 @@ private:
 	float cache_txt_rect2_x = 0.f;
 	uint32_t step_tm = 0;
 	uint32_t tm_last_update = 0;
+	Async::TimerId pause_timer_ = 0;
 	AdaptiveVsyncHandler adaptiveVsyncHD;
 };
 
@@ -6907,7 +9769,7 @@ public:
 
 	void Draw()
 	{
-		uint32_t diff_ = SDL_GetTicks() - m_start;
+		uint32_t diff_ = Volt::Clock::Get().nowMs() - m_start;
 		if (diff_ <= m_blink_tm) {
 			CacheRenderColor(renderer);
 			SDL_SetRenderDrawColor(renderer, m_color.r, m_color.g, m_color.b, m_color.a);
@@ -6917,7 +9779,10 @@ public:
 		}
 		
 		if (diff_ >= m_blink_tm * 2)
-			m_start = SDL_GetTicks();
+			m_start = Volt::Clock::Get().nowMs(), diff_ = 0;
+		// wake up for the next on/off flip instead of holding a redraw session
+		if (nullptr != adaptiveVsync)
+			adaptiveVsync->requestFrameAfter(diff_ <= m_blink_tm ? m_blink_tm - diff_ + 1 : m_blink_tm * 2 - diff_);
 	}
 
 private:
@@ -7084,6 +9949,7 @@ public:
 
 	ToggleButton& Build(Context* _context, ToggleButtonAttr tbr) {
 		setContext(_context);
+		subscribeEvents(EVC_POINTER);
 		attr = tbr;
 		state = attr.default_state;
 		//GLogger.Log(Logger::Level::Debug, "org dot rect{", attr.rect.x, attr.rect.y, attr.rect.w, attr.rect.h, "}");
@@ -7097,6 +9963,7 @@ public:
 			};
 		}
 		bounds = attr.rect;
+		markGeometryDirty();
 		//if (attr.rect.w > attr.rect.h) {
 		dotr = ph(attr.dot_rad_px / 2.f);
 		dotx = state == BtnState::OFF ? (dotr + bounds.x + (ph(100.f - attr.dot_rad_px) / 2.f)) : ((dotr + bounds.x + bounds.w) - ph(attr.dot_rad_px) - (ph(100.f - attr.dot_rad_px)));
@@ -7176,6 +10043,7 @@ public:
 		bounds.y += y;
 		dotx += x;
 		doty += y;
+		markGeometryDirty();
 	}
 
 private:
@@ -7712,6 +10580,7 @@ public:
     Scroll &Build(Context *_context, ScrollAttributes _attr)
     {
         setContext(_context);
+        subscribeEvents(EVC_POINTER);
         rect = _attr.rect;
         lvl_rect = rect;
         bg_color = _attr.bg_color;
@@ -7913,6 +10782,7 @@ public:
 	Slider &Build(Context *_context, Slider::Attributes _attr)
 	{
 		setContext(_context);
+		subscribeEvents(EVC_GESTURE);
 		knob.setContext(_context);
 		knob.Build(0.f, 0.f,
 				   to_cust(_attr.knob_radius,
@@ -7920,6 +10790,8 @@ public:
 				   _attr.knob_color);
 		rect = _attr.rect;
 		lvl_rect = rect;
+		bounds = rect;
+		markGeometryDirty();
 		bg_color = _attr.bg_color;
 		lvl_bar_color = _attr.level_bar_color;
 		orientation = _attr.orientation;
@@ -7930,43 +10802,45 @@ public:
 		return *this;
 	}
 
-	bool handleEvent() override
+	bool handleEvent() override
+	{
+		return false;
+	}
+
+	// press and drag come in as gestures, a tap jumps to the tapped value
+	bool onGesture(const Gesture::Event &_gesture) override
 	{
-		bool result = false;
-		switch (event->type)
+		using Gesture::Type;
+		switch (_gesture.type)
 		{
-		case EVT_MOUSE_BTN_DOWN:
-			if (pointInBound(event->motion.x, event->motion.y))
-			{
-				key_down = true, result = true;
-				if (Orientation::VERTICAL == orientation)
-					updateValue(screenToWorld(event->motion.y - (pv->getRealY() + rect.y)));
-				else if (Orientation::HORIZONTAL == orientation)
-					updateValue(screenToWorld(event->motion.x - (pv->getRealX() + rect.x)));
-			}
-			break;
-		case EVT_MOUSE_MOTION:
-			if (key_down)
-			{
-				result = true;
-				if (Orientation::VERTICAL == orientation)
-					updateValue(screenToWorld(event->motion.y - (pv->getRealY() + rect.y)));
-				else if (Orientation::HORIZONTAL == orientation)
-					updateValue(screenToWorld(event->motion.x - (pv->getRealX() + rect.x)));
-			}
-			break;
-		case EVT_MOUSE_BTN_UP:
-			if(key_down){
-				result = true;
-				if(onChangeEnd)
-					onChangeEnd(*this);
-			}
+		case Type::Tap:
+			if (not pointInBound(_gesture.x, _gesture.y))
+				return false;
+			slideTo(_gesture.x, _gesture.y);
+			if (onChangeEnd)
+				onChangeEnd(*this);
+			return true;
+		case Type::DragStart:
+			if (not pointInBound(_gesture.x, _gesture.y))
+				return false;
+			key_down = true;
+			slideTo(_gesture.x, _gesture.y);
+			return true;
+		case Type::Drag:
+			if (not key_down)
+				return false;
+			slideTo(_gesture.x, _gesture.y);
+			return true;
+		case Type::DragEnd:
+			if (not key_down)
+				return false;
 			key_down = false;
-			break;
+			if (onChangeEnd)
+				onChangeEnd(*this);
+			return true;
 		default:
-			break;
+			return false;
 		}
-		return result;
 	}
 
 	void draw() override
@@ -8062,6 +10936,8 @@ public:
 	{
 		rect.x += dx;
 		rect.y += dy;
+		bounds = rect;
+		markGeometryDirty();
 		lvl_rect.x += dx;
 		lvl_rect.y += dy;
 		knob.dest.x += dx;
@@ -8086,6 +10962,14 @@ private:
 		return false;
 	}
 
+	void slideTo(float x, float y)
+	{
+		if (Orientation::VERTICAL == orientation)
+			updateValue(screenToWorld(y - (pv->getRealY() + rect.y)));
+		else if (Orientation::HORIZONTAL == orientation)
+			updateValue(screenToWorld(x - (pv->getRealX() + rect.x)));
+	}
+
 	float screenToWorld(const float val) const
 	{
 		if (Orientation::HORIZONTAL == orientation)
@@ -8121,16 +11005,70 @@ template <typename T>
 		_t.getCellWidth();
 	};*/
 
-class CellBlock;
+class Cell;
+template <typename CellT = Cell>
+class BasicCellBlock;
+// the dynamic cell, widgets are added at runtime
+using CellBlock = BasicCellBlock<>;
 class Select;
 
-class Cell : public Context, public IView
+enum class CellType
 {
-private:
+	Norm,
+	Header,
+	Footer
+};
+
+/*
+	What BasicCellBlock needs from any cell type: identity, placement,
+	highlight state and the cached texture. Cell builds on it with runtime
+	widget lists, SchemaCell with a fixed set of widgets stored inline.
+	*/
+class CellBase : public Context, public IView
+{
+public:
+	using Type = CellType;
+
+	SharedTexture texture = nullptr;
+	bool redraw = true;
+	uint64_t index = 0;
+	SDL_Color bg_color = {0x00, 0x00, 0x00, 0x00};
+	SDL_Color onHoverBgColor = {0x00, 0x00, 0x00, 0x00};
+	float corner_radius = 0.f;
+	bool selected = false;
+	bool isHighlighted = false;
+	bool highlightOnHover = false;
+	Type _type{};
+
+	inline bool isPointInBound(float x, float y) const noexcept
+	{
+		if (x > pv->getRealX() + bounds.x && x < (pv->getRealX() + bounds.x + bounds.w) && y > pv->getRealY() + bounds.y && y < pv->getRealY() + bounds.y + bounds.h)
+			return true;
+
+		return false;
+	}
+
+	inline void updatePosBy(float _dx, float _dy) override
+	{
+		bounds.x += _dx;
+		bounds.y += _dy;
+		markGeometryDirty();
+	}
+
+protected:
+	template <typename>
+	friend class BasicCellBlock;
+
 	// private helpers used by CellBlock
 	uint32_t num_vert_grids = 1;
-	float org_mx = 0.f, org_my = 0.f, mx = 0.f, my = 0.f,
-		  scroll_y = 0.f, max_scroll = 0.f, dy = 0.f;
+	float org_mx = 0.f, org_my = 0.f, mx = 0.f, my = 0.f;
+	bool cellblock_parent = false;
+};
+
+class Cell : public CellBase
+{
+private:
+	float scroll_y = 0.f, max_scroll = 0.f, dy = 0.f;
 	/*current finger*/
 	v2d_generic<float> cf = {0.f, 0.f};
 	/*previous finger*/
@@ -8147,7 +11085,6 @@ private:
 		Right
 	};
 	ScrollAction scrlAction;
-	bool cellblock_parent = false;
 private:
 	inline void updatePosByInternal(float _dx, float _dy)
 	{
@@ -8198,24 +11135,18 @@ private:
 	}
 
 public:
-	friend class CellBlock;
+	template <typename>
+	friend class BasicCellBlock;
 	using FormData = std::unordered_map<std::string, std::string>;
 
 public:
-	SharedTexture texture = nullptr;
-	bool redraw = true;
-
-public:
-	uint64_t index = 0;
-	SDL_Color bg_color = {0x00, 0x00, 0x00, 0x00};
-	SDL_Color onHoverBgColor = {0x00, 0x00, 0x00, 0x00};
-	float corner_radius = 0.f;
 	std::any user_data, dataSetChangedData;
-	std::function<void(Cell &)> customDrawCallback = nullptr;
-	std::function<bool(Cell &)> customEventHandlerCallback = nullptr;
+	// called per cell every frame / event, kept inline so dispatch never allocates
+	Volt::InplaceFunction<void(Cell &)> customDrawCallback = nullptr;
+	Volt::InplaceFunction<bool(Cell &)> customEventHandlerCallback = nullptr;
 	std::function<void(Cell &, std::any _data)> onDataSetChanged = nullptr;
 	std::function<void(Cell &, FormData _data)> onFormSubmit = nullptr;
-	std::function<void(Cell &)> onUpdateCallback = nullptr;
+	Volt::InplaceFunction<void(Cell &)> onUpdateCallback = nullptr;
 	std::deque<TextBox> textBox;
 	std::deque<TextArea> textArea;
 	std::deque<EditBox> editBox;
@@ -8228,21 +11159,12 @@ public:
 	// std::deque<std::shared_ptr<CellBlock>> blocks;
 	//std::vector<CellBlock> blocks;
 	Scroll scroll{};
-	bool selected = false;
-	bool isHighlighted = false;
-	bool highlightOnHover = false;
 	bool ignoreTextEvents = true;
     bool has_scroll_bar=false;
 
 	std::vector<Cell> header_footer{};
 	//std::vector<Select> select;
 
-	enum class Type {
-		Norm,
-		Header,
-		Footer
-	} _type{};
-
 	float header_h = 0.f;
 	float footer_h = 0.f;
 
@@ -8271,13 +11193,13 @@ public:
 		return *this;
 	}
 
-	inline Cell &registerCustomDrawCallback(std::function<void(Cell &)> _customDrawCallback) noexcept
+	inline Cell &registerCustomDrawCallback(Volt::InplaceFunction<void(Cell &)> _customDrawCallback) noexcept
 	{
 		this->customDrawCallback = std::move(_customDrawCallback);
 		return *this;
 	}
 
-	inline Cell &registerCustomEventHandlerCallback(std::function<bool(Cell &)> _customEventHandlerCallback) noexcept
+	inline Cell &registerCustomEventHandlerCallback(Volt::InplaceFunction<bool(Cell &)> _customEventHandlerCallback) noexcept
 	{
 		this->customEventHandlerCallback = std::move(_customEventHandlerCallback);
 		return *this;
@@ -8622,20 +11544,6 @@ public:
 		return *this;
 	}
 
-	inline bool isPointInBound(float x, float y) const noexcept
-	{
-		if (x > pv->getRealX() + bounds.x && x < (pv->getRealX() + bounds.x + bounds.w) && y > pv->getRealY() + bounds.y && y < pv->getRealY() + bounds.y + bounds.h)
-			return true;
-
-		return false;
-	}
-
-	inline void updatePosBy(float _dx, float _dy) override
-	{
-		bounds.x += _dx;
-		bounds.y += _dy;
-	}
-
 	inline void notifyDataSetChanged(std::any _dataSetChangedData)
 	{
 		// add a check for empty _dataSetChangedData before storing
@@ -8702,6 +11610,7 @@ public:
 				next_w > 0.f && next_h > 0.f)
 			{
 				bounds = { next_x, next_y, next_w, next_h };
+				markGeometryDirty();
 
 				// 3. Cascade the EVT_WPSC event down so other 
 				// elements can properly calculate their new proportional layouts!
@@ -8912,6 +11821,24 @@ public:
 		return result;
 	}
 
+	// sliders and added views, handed over by BasicCellBlock::onGesture()
+	bool onGesture(const Gesture::Event &_gesture) override
+	{
+		if (isHidden())
+			return false;
+		bool result = false;
+		for (auto &_slider : sliders)
+			if (not _slider.isHidden() and (result = _slider.onGesture(_gesture)))
+				break;
+		if (not result)
+			for (auto view : iViews)
+				if (not view->isHidden() and (result = view->onGesture(_gesture)))
+					break;
+		if (result)
+			redraw = true;
+		return result;
+	}
+
 	void onUpdate() override
 	{
         for(auto* vw:childViews){
@@ -8974,8 +11901,10 @@ public:
 					//GLogger.Log(Logger::Level::Debug, "highlight on hover");
 				}
 
+				SpriteAtlas::Get().beginBatch();
 				for (auto &imgBtn : imageButton)
 					imgBtn.draw();
+				SpriteAtlas::Get().endBatch();
 				for (auto &textBx : textBox)
 					textBx.draw();
 				for (auto& textAr : textArea)
@@ -9118,6 +12047,228 @@ private:
 };
 
 
+// one entry of a SchemaCell schema: N widgets of type T
+template <typename T, std::size_t N = 1>
+struct CellSlot
+{
+	using type = T;
+	static constexpr std::size_t count = N;
+};
+
+/*
+	A cell whose widgets are fixed at compile time, for lists where every row
+	has the same shape:
+
+		using Row = SchemaCell<CellSlot<TextArea, 2>, CellSlot<ToggleButton>>;
+		BasicCellBlock<Row> list;
+		list.setOnFillNewCellData([&list](Row &row) {
+			list.setCellRect(row, 1, 48.f);
+			row.get<TextArea>(0).Build(&row, {.text = "Wi-Fi", .bounds = row.cellRect({2.f, 10.f, 60.f, 80.f})});
+			...
+		});
+
+	Widgets live inline in the cell, one std::array per slot instead of a
+	deque per widget type, and draw/event/update dispatch is unrolled over the
+	slots at compile time with direct calls. Every widget is default
+	constructed with the cell and must be built in the fill callback; hide the
+	ones a row doesn't use. Use Cell when rows differ in shape or need forms,
+	headers/footers or inner scrolling.
+	*/
+template <typename... Slots>
+class SchemaCell : public CellBase
+{
+	static_assert(sizeof...(Slots) > 0, "a cell schema needs at least one slot");
+
+public:
+	Volt::InplaceFunction<void(SchemaCell &)> onUpdateCallback = nullptr;
+
+	SchemaCell &setContext(Context *context_) noexcept
+	{
+		Context::setContext(context_);
+		Context::setView(this);
+		return *this;
+	}
+
+	SchemaCell &setIndex(const uint64_t &_index) noexcept
+	{
+		this->index = _index;
+		return *this;
+	}
+
+	// the widgets of slot I
+	template <std::size_t I>
+	auto &slot() noexcept
+	{
+		return std::get<I>(children_);
+	}
+
+	// the _n-th widget of the first slot holding T
+	template <typename T>
+	T &get(std::size_t _n = 0) noexcept
+	{
+		return std::get<slotOf<T>()>(children_)[_n];
+	}
+
+	// widget rect from percentages of the cell, like Cell::add* take them
+	SDL_FRect cellRect(const SDL_FRect &_pct) const
+	{
+		return {pv->to_cust(_pct.x, bounds.w), pv->to_cust(_pct.y, bounds.h),
+				pv->to_cust(_pct.w, bounds.w), pv->to_cust(_pct.h, bounds.h)};
+	}
+
+	SchemaCell &hideAll()
+	{
+		forEachChild([](IView &v) { v.hide(); });
+		redraw = true;
+		return *this;
+	}
+
+	SchemaCell &showAll()
+	{
+		forEachChild([](IView &v) { v.show(); });
+		redraw = true;
+		return *this;
+	}
+
+	bool handleEvent() override
+	{
+		if (event->type == EVT_RENDER_TARGETS_RESET)
+		{
+			texture.reset();
+			forEachChild([](IView &v) { v.handleEvent(); });
+			redraw = true;
+			return true;
+		}
+		if (event->type == EVT_WPSC)
+		{
+			const float next_x = DisplayInfo::Get().toUpdatedWidth(bounds.x);
+			const float next_y = DisplayInfo::Get().toUpdatedHeight(bounds.y);
+			const float next_w = DisplayInfo::Get().toUpdatedWidth(bounds.w);
+			const float next_h = DisplayInfo::Get().toUpdatedHeight(bounds.h);
+			if (std::isfinite(next_x) and std::isfinite(next_y) and std::isfinite(next_w) and std::isfinite(next_h) and
+				next_w > 0.f and next_h > 0.f)
+			{
+				bounds = {next_x, next_y, next_w, next_h};
+				markGeometryDirty();
+				forEachChild([](IView &v) { v.handleEvent(); });
+			}
+			redraw = true;
+			return false;
+		}
+		if (hidden)
+			return false;
+		if (event->type == EVT_FINGER_DOWN or event->type == EVT_FINGER_UP)
+		{
+			if (not isPointInBound(event->tfinger.x * DisplayInfo::Get().RenderW, event->tfinger.y * DisplayInfo::Get().RenderH))
+				return false;
+		}
+		// first child that takes the event wins, like Cell
+		bool result = anyChild([](IView &v) { return v.handleEvent(); });
+		if (event->type == EVT_FINGER_DOWN)
+			result = true;
+		if (not redraw)
+			redraw = result;
+		return result;
+	}
+
+	bool onGesture(const Gesture::Event &_gesture) override
+	{
+		if (hidden)
+			return false;
+		const bool result = anyChild([&_gesture](IView &v) { return not v.isHidden() and v.onGesture(_gesture); });
+		if (result)
+			redraw = true;
+		return result;
+	}
+
+	void onUpdate() override
+	{
+		std::apply([this](auto &...widgets) { (updateSlot(widgets), ...); }, children_);
+		if (onUpdateCallback != nullptr)
+			onUpdateCallback(*this);
+	}
+
+	void draw() override
+	{
+		if (isHidden())
+			return;
+		if (texture == nullptr)
+		{
+			texture = CreateSharedTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, (int)bounds.w, (int)bounds.h);
+			SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+		}
+		if (redraw)
+		{
+			CacheRenderTarget crt_(renderer);
+			SDL_SetRenderTarget(renderer, texture.get());
+			RenderClear(renderer, 0, 0, 0, 0);
+			if (not highlightOnHover and not isHighlighted)
+				RenderClear(renderer, bg_color.r, bg_color.g, bg_color.b, bg_color.a);
+			if ((highlightOnHover and isHighlighted) or selected)
+				RenderClear(renderer, onHoverBgColor.r, onHoverBgColor.g, onHoverBgColor.b, onHoverBgColor.a);
+			std::apply([](auto &...widgets) { (drawSlot(widgets), ...); }, children_);
+			redraw = false;
+			crt_.release(renderer);
+			transformToRoundedTexture(renderer, texture.get(), corner_radius);
+		}
+		RenderTexture(renderer, texture.get(), nullptr, &bounds);
+	}
+
+private:
+	template <typename T, std::size_t I = 0>
+	static constexpr std::size_t slotOf()
+	{
+		static_assert(I < sizeof...(Slots), "type not in the cell schema");
+		if constexpr (std::is_same_v<typename std::tuple_element_t<I, std::tuple<Slots...>>::type, T>)
+			return I;
+		else
+			return slotOf<T, I + 1>();
+	}
+
+	template <typename F>
+	void forEachChild(F &&_f)
+	{
+		std::apply([&_f](auto &...widgets)
+				   { ((std::for_each(widgets.begin(), widgets.end(), [&_f](auto &w) { _f(w); })), ...); },
+				   children_);
+	}
+
+	template <typename F>
+	bool anyChild(F &&_f)
+	{
+		return std::apply([&_f](auto &...widgets)
+						  { return (std::any_of(widgets.begin(), widgets.end(), [&_f](auto &w) { return _f(w); }) or ...); },
+						  children_);
+	}
+
+	template <typename T, std::size_t N>
+	static void drawSlot(std::array<T, N> &_widgets)
+	{
+		if constexpr (std::is_same_v<T, ImageButton>)
+			SpriteAtlas::Get().beginBatch();
+		for (T &w : _widgets)
+			if (not w.isHidden())
+				w.draw();
+		if constexpr (std::is_same_v<T, ImageButton>)
+			SpriteAtlas::Get().endBatch();
+	}
+
+	template <typename T, std::size_t N>
+	void updateSlot(std::array<T, N> &_widgets)
+	{
+		for (T &w : _widgets)
+		{
+			w.onUpdate();
+			// same redraw triggers as Cell::onUpdate
+			if constexpr (std::is_same_v<T, EditBox>)
+				redraw = redraw or w.isActive();
+			if constexpr (std::is_same_v<T, RunningText>)
+				redraw = true;
+		}
+	}
+
+	std::tuple<std::array<typename Slots::type, Slots::count>...> children_;
+};
 
 
 struct CellBlockProps
@@ -9130,7 +12281,8 @@ struct CellBlockProps
 	float cellSpacingY = 1.f;
 };
 
-class CellBlock : public Context, public IView
+template <typename CellT>
+class BasicCellBlock : public Context, public IView
 {
 public:
 	uint32_t prevLineCount = 0, consumedCells = 0, lineCount = 0, numPrevLineCells = 0;
@@ -9162,7 +12314,7 @@ public:
 		return this->CellSpacing;
 	}
 
-	const Cell &getLowestBoundCell() const noexcept
+	const CellT &getLowestBoundCell() const noexcept
 	{
 		return cells[bottomCell];
 	}
@@ -9177,12 +12329,12 @@ public:
 		return cells.empty();
 	}
 
-	Cell &back()
+	CellT &back()
 	{
 		return cells.back();
 	};
 
-	Cell &front()
+	CellT &front()
 	{
 		return cells.front();
 	};
@@ -9207,12 +12359,12 @@ public:
 		// data_set_changed=true;
 	}
 
-	Cell &getCell(std::size_t _index)
+	CellT &getCell(std::size_t _index)
 	{
 		return cells[_index];
 	}
 
-	Cell &getSelectedCell()
+	CellT &getSelectedCell()
 	{
 		return cells[SELECTED_CELL];
 	}
@@ -9222,7 +12374,7 @@ public:
 		return SELECTED_CELL;
 	}
 
-	CellBlock &setSelectedItem(const int64_t _selectedCell)
+	BasicCellBlock &setSelectedItem(const int64_t _selectedCell)
 	{
 		updateSelectedCell(_selectedCell);
 		adaptiveVsyncHD.startRedrawSession();
@@ -9234,19 +12386,20 @@ public:
 		cellsWithAsyncImages.push_back(_cell);
 	}
 
-	CellBlock &incrementYBy(const float &val) noexcept
+	BasicCellBlock &incrementYBy(const float &val) noexcept
 	{
 		this->bounds.y += val;
+		markGeometryDirty();
 		return *this;
 	}
 
-	CellBlock &setCellBGColor(const SDL_Color &_cell_bg_color) noexcept
+	BasicCellBlock &setCellBGColor(const SDL_Color &_cell_bg_color) noexcept
 	{
 		this->cell_bg_color = _cell_bg_color;
 		return *this;
 	}
 
-	CellBlock &updateHeight(const float &height)
+	BasicCellBlock &updateHeight(const float &height)
 	{
 		if (height == bounds.h)
 			return *this;
@@ -9256,6 +12409,7 @@ public:
 		else
 			dy = 0.f, scrlAction = ScrollAction::Down;
 		this->bounds.h = height;
+		markGeometryDirty();
 		this->margin.h += df;
 		if (texture.get() != nullptr)
 			texture.reset();
@@ -9272,42 +12426,43 @@ public:
 	{
 		bounds.x += dx, bounds.y += dy;
 		margin.x += dx, margin.y += dy;
+		markGeometryDirty();
 	};
 
-	CellBlock &setCellSpacing(const float cell_spacing) noexcept
+	BasicCellBlock &setCellSpacing(const float cell_spacing) noexcept
 	{
 		this->CellSpacing = cell_spacing;
 		return *this;
 	}
 
-	CellBlock &onClick(std::function<void(Cell &)> on_cell_clicked_callback) noexcept
+	BasicCellBlock &onClick(Volt::InplaceFunction<void(CellT &)> on_cell_clicked_callback) noexcept
 	{
 		onCellClickedCallback = std::move(on_cell_clicked_callback);
 		return *this;
 	}
 
-	CellBlock &setOnFillNewCellData(
-		std::function<void(Cell &)> _fillNewCellDataCallback) noexcept
+	BasicCellBlock &setOnFillNewCellData(
+		std::function<void(CellT &)> _fillNewCellDataCallback) noexcept
 	{
 		fillNewCellDataCallback = std::move(_fillNewCellDataCallback);
 		return *this;
 	}
 
-	CellBlock &updateNoMaxCells(const int &_noMaxCells) noexcept
+	BasicCellBlock &updateNoMaxCells(const int &_noMaxCells) noexcept
 	{
 		maxCells = _noMaxCells;
 		// first_load =true;
 		return *this;
 	}
 
-	CellBlock &updateNoMaxCellsBy(const int &_numCells) noexcept
+	BasicCellBlock &updateNoMaxCellsBy(const int &_numCells) noexcept
 	{
 		maxCells += _numCells;
 		// first_load =true;
 		return *this;
 	}
 
-	CellBlock &setEnabled(const bool &_enabled) noexcept
+	BasicCellBlock &setEnabled(const bool &_enabled) noexcept
 	{
 		enabled = _enabled;
 		return *this;
@@ -9318,7 +12473,7 @@ public:
 		return sizeOfPreAddedCells;
 	}
 
-	CellBlock &clearAndReset()
+	BasicCellBlock &clearAndReset()
 	{
 		update_top_and_bottom_cells();
 		ANIM_ACTION_DN = false;
@@ -9384,7 +12539,7 @@ public:
 	{
 	}
 
-	std::optional<std::reference_wrapper<Cell>> getHeaderCell()
+	std::optional<std::reference_wrapper<CellT>> getHeaderCell()
 	{
 		if (fillNewCellDataCallbackHeader and not cells.empty())
 		{
@@ -9398,18 +12553,18 @@ public:
 	}
 
 	// Note this method must be invoked before CellBlock::Build() and CellBlock::addCell
-	CellBlock &addHeaderCell(std::function<void(Cell &)> newCellSetUpCallback)
+	BasicCellBlock &addHeaderCell(std::function<void(CellT &)> newCellSetUpCallback)
 	{
 		fillNewCellDataCallbackHeader = newCellSetUpCallback;
 		return *this;
 	}
 
-	CellBlock &addFooterCell(std::function<void(Cell &)> newCellSetUpCallback)
+	BasicCellBlock &addFooterCell(std::function<void(CellT &)> newCellSetUpCallback)
 	{
 		return *this;
 	}
 
-	CellBlock &addCell(std::function<void(Cell &)> newCellSetUpCallback)
+	BasicCellBlock &addCell(std::function<void(CellT &)> newCellSetUpCallback)
 	{
 		if (!BuildWasCalled)
 		{
@@ -9442,9 +12597,10 @@ public:
 	 * this approach is not only faster but fixes the bug introduced by adding cells manually
 	 * on a non empty block
 	 */
-	CellBlock &setCellRect(Cell &_cell, uint32_t numVertGrids, const float h, const float margin_x = 0.f, const float margin_y = 0.f)
+	BasicCellBlock &setCellRect(CellT &_cell, uint32_t numVertGrids, const float h, const float margin_x = 0.f, const float margin_y = 0.f)
 	{
-		[[unlikely]] if (not (_cell._type == Cell::Type::Norm))
+		cell_grid_dirty_ = true;
+		[[unlikely]] if (not (_cell._type == CellType::Norm))
 		{
 			numVertGrids = numVerticalGrids;
 		}
@@ -9459,7 +12615,7 @@ public:
 		if (getMaxVerticalGrids() - consumedCells < numVertGrids)
 			lineCount++, _cell.bounds.y += margin_y;
 		SDL_FRect lbc;
-		if (_cell._type == Cell::Type::Norm)
+		if (_cell._type == CellType::Norm)
 			lbc = getLowestBoundCell().bounds;
 		else
 			lbc = header_cell.bounds;
@@ -9480,7 +12636,7 @@ public:
 		_cell.bounds.h = h - (margin_y * 2.f);
 		prevLineCount = lineCount;
 		consumedCells += numVertGrids;
-		[[unlikely]] if (_cell._type == Cell::Type::Header)
+		[[unlikely]] if (_cell._type == CellType::Header)
 		{
 			_cell.bounds.x += bounds.x;
 			_cell.bounds.y += bounds.y;
@@ -9636,15 +12792,18 @@ public:
 	{
 		bounds.y = _prev_view->bounds.y + _prev_view->bounds.h + _margin;
 		margin.y += _prev_view->bounds.y + _prev_view->bounds.h + _margin;
+		markGeometryDirty();
 	}
 
-	CellBlock &Build(Context *context_, const int &maxCells_, const int &_numVerticalGrids, const CellBlockProps &_blockProps, const ScrollDirection &scroll_direction = ScrollDirection::VERTICAL)
+	BasicCellBlock &Build(Context *context_, const int &maxCells_, const int &_numVerticalGrids, const CellBlockProps &_blockProps, const ScrollDirection &scroll_direction = ScrollDirection::VERTICAL)
 	{
 		Context::setContext(context_);
 		Context::setView(this);
 		adaptiveVsyncHD.setAdaptiveVsync(adaptiveVsync);
+		CellsAdaptiveVsync.setParent(adaptiveVsync);
 		pv = this;
 		bounds = _blockProps.rect;
+		markGeometryDirty();
 		margin = {
 			bounds.x + DisplayInfo::Get().to_cust(_blockProps.margin.left, bounds.w),
 			bounds.y + DisplayInfo::Get().to_cust(_blockProps.margin.top, bounds.h),
@@ -9663,8 +12822,8 @@ public:
 		if (fillNewCellDataCallbackHeader)
 		{
 			update_top_and_bottom_cells();
-			header_cell = Cell{};
-			header_cell._type = Cell::Type::Header;
+			header_cell = CellT{};
+			header_cell._type = CellType::Header;
 			header_cell.cellblock_parent = true;
 			header_cell.setContext(this)
 				.setIndex(0);
@@ -9746,7 +12905,7 @@ public:
 				visibleCells.push_back(&cells[backIndex]);
 			}
 			while (visibleCells[0]->bounds.y + visibleCells[0]->bounds.h < 0.f)
-				visibleCells.pop_front(), frontIndex = visibleCells.front()->index;
+				visibleCells.erase(visibleCells.begin()), frontIndex = visibleCells.front()->index;
 
 			scrlAction = ScrollAction::Up;
 		}
@@ -9830,6 +12989,7 @@ public:
 			resetTexture();
 			// handleFlexResize(dw);
 			allCellsHandleEvent();
+			cell_grid_dirty_ = true;
 			SIMPLE_RE_DRAW = true;
 		}
 		else if (event->type == EVT_FINGER_DOWN)
@@ -9854,6 +13014,8 @@ public:
 					return result;
 				SIMPLE_RE_DRAW = true;
 				KEYDOWN = true, interpolated.stop();
+				MOTION_OCCURED = false;
+				press_pt_ = {cf.x, cf.y};
 				visibleCellsHandleEvent();
 				result or_eq true;
 			}
@@ -9873,35 +13035,21 @@ public:
 					internal_handle_motion();
 					updateHighlightedCell(-1);
 					FingerUP_TM = SDL_GetTicks();
-					return true;
-				}
-				FingerUP_TM = SDL_GetTicks();
-			}*/
-		else if (event->type == EVT_FINGER_MOTION)
-		{
-			// visibleCellsHandleEvent();
-			if (KEYDOWN and maxCells > 0)
-			{
-				cf = { event->tfinger.x * DisplayInfo::Get().RenderW,
-					  event->tfinger.y * DisplayInfo::Get().RenderH };
-				MOTION_OCCURED = true;
-				if (std::fabs(cf.y - pf.y) < 2.f)MOTION_OCCURED = false;
-				/*dc += event->tfinger.dy  * DisplayInfo::Get().RenderH;
-				if (std::fabs(dc) < 4.f)
-				{
-					skipFrame = true;
-					return true;
-				}
-				dc = 0.f;*/
-				internal_handle_motion();
-				updateHighlightedCell(-1);
-				movedDistance += {0.f, dy};
-				if (SDL_fabsf(dy) < 2.f)
-				{
-					scrlAction = ScrollAction::None;
-				}
-				else
-					FingerUP_TM = SDL_GetTicks();
+					return true;
+				}
+				FingerUP_TM = SDL_GetTicks();
+			}*/
+		else if (event->type == EVT_FINGER_MOTION)
+		{
+			// visibleCellsHandleEvent();
+			if (KEYDOWN and maxCells > 0)
+			{
+				// the scrolling itself follows the Drag gestures, see onGesture();
+				// past the tap slop the release is no longer a cell tap
+				const float mx = event->tfinger.x * DisplayInfo::Get().RenderW;
+				const float my = event->tfinger.y * DisplayInfo::Get().RenderH;
+				if (std::hypot(mx - press_pt_.x, my - press_pt_.y) > InputStage::Get().recognizer().config().tap_slop_px)
+					MOTION_OCCURED = true;
 				return true;
 			}
 			FingerUP_TM = SDL_GetTicks();
@@ -9914,26 +13062,17 @@ public:
 				// current finger
 				cf = {(float)event->motion.x, (float)event->motion.y};
 				// current finger transformed
-				const v2d_generic<float> cf_trans = {cf.x - margin.x, cf.y - margin.y};
 				bool cellFound = false;
 				if (isPosInbound(event->motion.x, event->motion.y))
 				{
 					result = true;
-					auto fc = std::find_if(visibleCells.begin(), visibleCells.end(),
-										   [this, &cf_trans, &cellFound](Cell *cell) {
-											   if (cf_trans.y >= cell->bounds.y and
-												   cf_trans.y <= cell->bounds.y + cell->bounds.h and
-												   cf_trans.x >= cell->bounds.x and
-												   cf_trans.x <= cell->bounds.x + cell->bounds.w)
-											   {
-												   cell->handleEvent();
-												   updateHighlightedCell(cell->index);
-												   SIMPLE_RE_DRAW = true;
-												   cellFound = true;
-												   return true;
-											   }
-											   return false;
-										   });
+					if (CellT *cell = visibleCellAt(cf.x, cf.y))
+					{
+						cell->handleEvent();
+						updateHighlightedCell(cell->index);
+						SIMPLE_RE_DRAW = true;
+						cellFound = true;
+					}
 					if (not cellFound)
 					{
 						if (HIGHLIGHTED_CELL >= 0)
@@ -9954,7 +13093,6 @@ public:
 		{
 			////to do: should not use the time processed by the application
 			// to measure the time between events instead use event.time
-			const auto finger_up_dt = (SDL_GetTicks() - FingerUP_TM);
 			interpolated.stop();
 			dc = 0.f;
 			// SDL_Log("f∆");
@@ -9969,7 +13107,7 @@ public:
 					result = true;
 					// SDL_Log("s2");
 					auto fc = std::find_if(visibleCells.begin(), visibleCells.end(),
-										   [this](Cell *cell)
+										   [this](CellT *cell)
 										   {
 											   // SDL_Log("s3:%f,%f,%f,%f",cell->bounds.x,cell->bounds.y,cell->bounds.w,cell->bounds.h);
 											   if (/*cf_trans.y >= cell->bounds.y and
@@ -9995,36 +13133,104 @@ public:
 				}
 			}
 
-			if (MOTION_OCCURED and isPosInbound(cf.x, cf.y) and isBlockScrollable())
-			{
-				result = true;
-				// SDL_Log("FU_TM: %d", finger_up_dt);
-				float dt = static_cast<float>((FingerUP_TM - FingerMotion_TM));
+			KEYDOWN = false;
+			MOTION_OCCURED = false;
+		}
+		/*else if (event->type == SDL_WINDOWEVENT) {
+				//if (event.window.type == SDL_WINDOWEVENT) {
+				//	//SDL_GetWindowPosition(window, NULL, NULL);
+				//	//SDL_Log("WARN: WINDOW_EVENT");
+				//}
+			}*/
+		else
+		{
+			visibleCellsHandleEvent();
+		}
+
+		if (CELL_PRESSED or SIMPLE_RE_DRAW or !interpolated.isDone() or CellsAdaptiveVsync.hasRequests())
+		{
+			adaptiveVsyncHD.startRedrawSession();
+			dy = 0.f;
+		}
 
-				if (finger_up_dt > 100)
-					dt = 30000.f, movedDistance.y = 0.01f;
+		if (not toBeErasedCells.empty())
+			SIMPLE_RE_DRAW = false;
+		return result;
+	}
 
-				if (dt <= 0.f)
-					dt = 0.000001f;
-				auto speed = ((SDL_fabsf(movedDistance.y) / dt)*15);
+	// Scrolling follows the Drag gestures and a Fling carries it on. A drag
+	// starting on a cell widget that takes it (a Slider) stays with that cell.
+	bool onGesture(const Gesture::Event &_gesture) override
+	{
+		using Gesture::Type;
+		if (not enabled or hidden)
+			return false;
+		bool result = false;
+		switch (_gesture.type)
+		{
+		case Type::DragStart:
+			gesture_cell_index_ = -1, dragging_ = false;
+			if (not isPosInbound(_gesture.x, _gesture.y))
+				return false;
+			if (CellT *cell = visibleCellAt(_gesture.x, _gesture.y); nullptr != cell and cell->onGesture(_gesture))
+			{
+				gesture_cell_index_ = static_cast<int64_t>(cell->index);
+				SIMPLE_RE_DRAW = true;
+				result = true;
+				break;
+			}
+			dragging_ = true, interpolated.stop();
+			pf = {_gesture.x, _gesture.y};
+			movedDistance = {0.f, 0.f};
+			SIMPLE_RE_DRAW = true;
+			result = true;
+			break;
+		case Type::Drag:
+			if (CellT *cell = gestureCell())
+			{
+				result = cell->onGesture(_gesture);
+				SIMPLE_RE_DRAW = true;
+				break;
+			}
+			if (not dragging_ or maxCells == 0)
+				return false;
+			cf = {_gesture.x, _gesture.y};
+			internal_handle_motion();
+			updateHighlightedCell(-1);
+			movedDistance += {0.f, dy};
+			if (SDL_fabsf(dy) < 2.f)
+				scrlAction = ScrollAction::None;
+			else
+				FingerUP_TM = SDL_GetTicks();
+			return true;
+		case Type::DragEnd:
+			if (CellT *cell = gestureCell())
+			{
+				result = cell->onGesture(_gesture);
+				SIMPLE_RE_DRAW = true;
+				break;
+			}
+			result = dragging_;
+			dragging_ = false;
+			break;
+		case Type::Fling:
+			if (CellT *cell = gestureCell())
+			{
+				result = cell->onGesture(_gesture);
+				gesture_cell_index_ = -1;
+				SIMPLE_RE_DRAW = true;
+				break;
+			}
+			if (isPosInbound(_gesture.x, _gesture.y) and isBlockScrollable())
+			{
+				result = true;
+				auto speed = (SDL_fabsf(_gesture.vy) / 1000.f) * 15;
 				if (speed <= 0.f)
 					speed = 0.000001f;
-				// SDL_Log("Speed: %f", speed);
-				/*if (finger_up_dt > 45)
-					speed *= 10.f;*/
-				// SDL_Log("moved distance: %f DT: %f  speed: %f", fabs(movedDistance.y), dt, speed);
-				if (movedDistance.y >= 0.f)
+				if (_gesture.vy >= 0.f)
 					ANIM_ACTION_DN = true;
 				else
 					ANIM_ACTION_UP = true;
-				/*
-				if (speed > 0)
-					scroll_step = (float)speed / 4.f;
-				else
-					scroll_step = 10.f;*/
-				/*interpolated.setTransitionFunction(TransitionFunction::EaseOutQuad);
-				interpolated.setValue(speed);
-				interpolated.setDuration(speed / 8.f);*/
 
 				// compute a sane fling magnitude
 				const float minFling = 1.f;
@@ -10041,29 +13247,15 @@ public:
 
 				movedDistance = {0.f, 0.f};
 			}
-
-			KEYDOWN = false;
-			MOTION_OCCURED = false;
-		}
-		/*else if (event->type == SDL_WINDOWEVENT) {
-				//if (event.window.type == SDL_WINDOWEVENT) {
-				//	//SDL_GetWindowPosition(window, NULL, NULL);
-				//	//SDL_Log("WARN: WINDOW_EVENT");
-				//}
-			}*/
-		else
-		{
-			visibleCellsHandleEvent();
+			break;
+		default:
+			break;
 		}
-
 		if (CELL_PRESSED or SIMPLE_RE_DRAW or !interpolated.isDone() or CellsAdaptiveVsync.hasRequests())
 		{
 			adaptiveVsyncHD.startRedrawSession();
 			dy = 0.f;
 		}
-
-		if (not toBeErasedCells.empty())
-			SIMPLE_RE_DRAW = false;
 		return result;
 	}
 
@@ -10173,7 +13365,7 @@ public:
 			{
 				movedDistanceSinceStart.y += dy;
 				// std::for_each(cells.begin(), cells.end(), [this](Cell<CustomCellData>& cell) {Async::GThreadPool.enqueue(&Cell<CustomCellData>::updatePosBy, &cell,0.f, dy); });
-				std::for_each(cells.begin(), cells.end(), [this](Cell &cell)
+				std::for_each(cells.begin(), cells.end(), [this](CellT &cell)
 							  { cell.updatePosBy(0.f, dy); });
 			}
 			if (CELL_PRESSED)
@@ -10227,6 +13419,41 @@ public:
 		}
 	}
 
+	// visible cell under the window space point (x, y), nullptr if none. Backed
+	// by a grid rebuilt only when the block scrolled, moved, recycled cells or
+	// was laid out again; cells scroll together, so the first one stands for all.
+	CellT *visibleCellAt(float x, float y)
+	{
+		CellT *first = visibleCells.empty() ? nullptr : visibleCells.front();
+		const float first_y = nullptr != first ? first->bounds.y : 0.f;
+		if (cell_grid_dirty_ or cell_grid_first_ != first or cell_grid_first_y_ != first_y or
+			cell_grid_count_ != visibleCells.size() or cell_grid_origin_.x != margin.x or cell_grid_origin_.y != margin.y)
+		{
+			cell_grid_.begin();
+			for (CellT *cell : visibleCells)
+				cell_grid_.add(cell, {margin.x + cell->bounds.x, margin.y + cell->bounds.y, cell->bounds.w, cell->bounds.h});
+			cell_grid_.finish();
+			cell_grid_dirty_ = false;
+			cell_grid_first_ = first;
+			cell_grid_first_y_ = first_y;
+			cell_grid_count_ = visibleCells.size();
+			cell_grid_origin_ = {margin.x, margin.y};
+		}
+		return cell_grid_.topmost(x, y).value_or(nullptr);
+	}
+
+private:
+	// looked up again each time, the cell deque may have been recycled
+	CellT *gestureCell()
+	{
+		if (gesture_cell_index_ < 0)
+			return nullptr;
+		for (CellT *cell : visibleCells)
+			if (static_cast<int64_t>(cell->index) == gesture_cell_index_)
+				return cell;
+		return nullptr;
+	}
+
 protected:
 	void simpleDraw()
 	{
@@ -10281,7 +13508,7 @@ protected:
 			visibleCells.push_back(&cells[backIndex]);
 		}
 		while (visibleCells[0]->bounds.y + visibleCells[0]->bounds.h < 0.f)
-			visibleCells.pop_front(), frontIndex = visibleCells.front()->index;
+			visibleCells.erase(visibleCells.begin()), frontIndex = visibleCells.front()->index;
 	}
 
 	void scrollDown()
@@ -10289,7 +13516,7 @@ protected:
 		while (visibleCells[0]->index > cells.front().index and visibleCells[0]->bounds.y + visibleCells[0]->bounds.h > 0.f)
 		{
 			--frontIndex;
-			visibleCells.push_front(&cells[frontIndex]);
+			visibleCells.insert(visibleCells.begin(), &cells[frontIndex]);
 			update_top_and_bottom_cells();
 		}
 		while (visibleCells.back()->bounds.y > margin.h)
@@ -10312,8 +13539,9 @@ protected:
 		std::size_t tmp_top_cell = 0;
 		float largest = 0.f, tmp_largest = 0.f;
 		std::size_t tmp_bottom_cell = 0;
-		std::for_each(std::execution::par, visibleCells.begin(), visibleCells.end(),
-					  [&smallest, &tmp_smallest, &tmp_top_cell, &largest, &tmp_largest, &tmp_bottom_cell](const Cell *cell)
+		// a screenful of cells, a parallel pass would cost more (and raced on the minima)
+		std::for_each(visibleCells.begin(), visibleCells.end(),
+					  [&smallest, &tmp_smallest, &tmp_top_cell, &largest, &tmp_largest, &tmp_bottom_cell](const CellT *cell)
 					  {
 						  tmp_smallest = cell->bounds.y;
 						  tmp_largest = cell->bounds.y + cell->bounds.h;
@@ -10446,17 +13674,30 @@ private:
 	ScrollAction scrlAction;
 
 private:
-	std::function<void(Cell &)> onCellClickedCallback = nullptr;
-	std::function<void(Cell &)> fillNewCellDataCallback = nullptr;
-	std::function<void(Cell &)> fillNewCellDataCallbackHeader = nullptr;
-	std::deque<Cell> cells;
-	std::deque<Cell *> visibleCells;
+	Volt::InplaceFunction<void(CellT &)> onCellClickedCallback = nullptr;
+	std::function<void(CellT &)> fillNewCellDataCallback = nullptr;
+	std::function<void(CellT &)> fillNewCellDataCallbackHeader = nullptr;
+	std::deque<CellT> cells;
+	// a screenful of cells; a vector keeps its capacity while scrolling, the
+	// deque allocated and freed blocks as cells went in and out
+	std::vector<CellT *> visibleCells;
 	std::deque<ImageButton *> cellsWithAsyncImages;
-	std::deque<std::function<void(Cell &)>> preAddedCellsSetUpCallbacks;
+	std::deque<std::function<void(CellT &)>> preAddedCellsSetUpCallbacks;
 	std::vector<std::size_t> toBeErasedCells;
-	Cell header_cell, footer_cell;
+	CellT header_cell, footer_cell;
 	AdaptiveVsyncHandler adaptiveVsyncHD;
 	AdaptiveVsync CellsAdaptiveVsync;
+	// the drag went to this cell's widgets instead of scrolling, see onGesture()
+	int64_t gesture_cell_index_ = -1;
+	bool dragging_ = false;
+	SDL_FPoint press_pt_ = {0.f, 0.f};
+	// see visibleCellAt()
+	Spatial::UniformGrid<CellT *> cell_grid_;
+	CellT *cell_grid_first_ = nullptr;
+	float cell_grid_first_y_ = 0.f;
+	size_t cell_grid_count_ = 0;
+	SDL_FPoint cell_grid_origin_ = {0.f, 0.f};
+	bool cell_grid_dirty_ = true;
 	SDL_FRect margin;
 	SharedTexture texture = nullptr;
 	SDL_Color cell_bg_color = {0x00, 0x00, 0x00, 0x00};
@@ -10585,6 +13826,7 @@ public:
 		viewValue.bg_color = _props.bg_color;
 		viewValue.corner_radius = _props.corner_radius;
 		viewValue.bounds = bounds;
+		viewValue.markGeometryDirty();
 		if (_values.size())
 		{
 			viewValue.addTextBox(
@@ -10806,6 +14048,7 @@ public:
 		viewValue.bg_color = _props.bg_color;
 		viewValue.corner_radius = _props.corner_radius;
 		viewValue.bounds = bounds;
+		viewValue.markGeometryDirty();
 
 		valuesBlock.setOnFillNewCellData(_valueCellOnCreateCallback);
 		valuesBlock.Build(_context, _max_values, _numVerticalGrid,
@@ -10989,6 +14232,7 @@ public:
 		setContext(_context);
 		pv = this;
 		bounds = _menuProps.rect;
+		markGeometryDirty();
 
 		menu_block.Build(_context, 0, NumVerticalModules, _menuProps);
 
@@ -11014,7 +14258,7 @@ public:
 		return *this;
 	}
 
-	Menu &onClick(std::function<void(Cell &)> on_cell_clicked_callback)
+	Menu &onClick(Volt::InplaceFunction<void(Cell &)> on_cell_clicked_callback)
 	{
 		menu_block.onClick(std::move(on_cell_clicked_callback));
 		return *this;
@@ -11025,6 +14269,11 @@ public:
 		return menu_block.handleEvent();
 	}
 
+	bool onGesture(const Gesture::Event &_gesture) override
+	{
+		return menu_block.onGesture(_gesture);
+	}
+
 	void draw() override
 	{
 		menu_block.draw();
@@ -11046,6 +14295,438 @@ private:
 	bool build_successful = false;
 };
 
+/*
+	Widget types a compiled UI description (UiBlobCore.hpp) can name. Each
+	entry knows its object size so UiScreen can place all widgets of a type
+	in one buffer, and a build function reading the node's attributes. text,
+	toggle and slider are built in; row, column and any other unregistered
+	type are layout-only boxes.
+	*/
+class UiWidgets
+{
+public:
+	// builds a default constructed widget for its node and frame
+	template <typename T>
+	using BuildFn = void (*)(T &, Context *, const UiBlob::Reader &, uint32_t _node, const SDL_FRect &_frame);
+
+	struct Entry
+	{
+		size_t size = 0, align = 0;
+		void (*construct)(void *) = nullptr;
+		void (*destroy)(void *) = nullptr;
+		IView *(*view)(void *) = nullptr;
+		// the registered BuildFn<T>, called through build()
+		void (*build_fn)() = nullptr;
+		void (*build)(void (*)(), void *, Context *, const UiBlob::Reader &, uint32_t, const SDL_FRect &) = nullptr;
+		bool measure_text = false;
+	};
+
+	static UiWidgets &Get()
+	{
+		static UiWidgets instance;
+		return instance;
+	}
+
+	UiWidgets(const UiWidgets &) = delete;
+	UiWidgets(UiWidgets &&) = delete;
+
+	// _measure_text: without a fixed size the node is sized by its "text"
+	// attribute and "font-size"
+	template <typename T>
+	UiWidgets &add(const std::string &_type, BuildFn<T> _build, bool _measure_text = false)
+	{
+		static_assert(std::is_base_of_v<IView, T> and std::is_default_constructible_v<T>);
+		Entry entry;
+		entry.size = sizeof(T);
+		entry.align = alignof(T);
+		entry.construct = [](void *p) { ::new (p) T(); };
+		entry.destroy = [](void *p) { static_cast<T *>(p)->~T(); };
+		entry.view = [](void *p) -> IView * { return static_cast<T *>(p); };
+		entry.build_fn = reinterpret_cast<void (*)()>(_build);
+		entry.build = [](void (*fn)(), void *p, Context *c, const UiBlob::Reader &r, uint32_t n, const SDL_FRect &f)
+		{ reinterpret_cast<BuildFn<T>>(fn)(*static_cast<T *>(p), c, r, n, f); };
+		entry.measure_text = _measure_text;
+		entries_[_type] = entry;
+		return *this;
+	}
+
+	const Entry *find(std::string_view _type) const
+	{
+		auto it = entries_.find(Volt::StringId(_type));
+		return it == entries_.end() ? nullptr : &it->second;
+	}
+
+	static SDL_Color color(uint32_t _rgba)
+	{
+		return {static_cast<Uint8>(_rgba >> 24), static_cast<Uint8>(_rgba >> 16), static_cast<Uint8>(_rgba >> 8), static_cast<Uint8>(_rgba)};
+	}
+
+private:
+	UiWidgets()
+	{
+		add<TextArea>("text", [](TextArea &w, Context *c, const UiBlob::Reader &r, uint32_t n, const SDL_FRect &f)
+					  {
+						  TextArea::Attributes attr;
+						  attr.text = r.text(n, "text");
+						  attr.bounds = f;
+						  attr.fg_col = color(r.color(n, "fg", 0x000000ff));
+						  attr.bg_col = color(r.color(n, "bg", 0x00000000));
+						  attr.font_size = r.number(n, "font-size");
+						  attr.corner_radius = r.number(n, "corner-radius");
+						  attr.max_lines = static_cast<uint32_t>(r.number(n, "max-lines"));
+						  const std::string_view gravity = r.text(n, "gravity", "left");
+						  attr.gravity = gravity == "center" ? Gravity::Center : gravity == "right" ? Gravity::Right : Gravity::Left;
+						  w.Build(c, std::move(attr)); }, true);
+		add<ToggleButton>("toggle", [](ToggleButton &w, Context *c, const UiBlob::Reader &r, uint32_t n, const SDL_FRect &f)
+						  {
+							  ToggleButtonAttr attr;
+							  attr.rect = f;
+							  attr.bg = color(r.color(n, "bg", 0xffffffff));
+							  attr.bg_on_color = color(r.color(n, "bg-on", 0x00ff00ff));
+							  attr.dot_color = color(r.color(n, "dot", 0x000000ff));
+							  attr.dot_on_color = color(r.color(n, "dot-on", 0x000000ff));
+							  attr.default_state = r.boolean(n, "on") ? BtnState::ON : BtnState::OFF;
+							  w.Build(c, std::move(attr)); });
+		add<Slider>("slider", [](Slider &w, Context *c, const UiBlob::Reader &r, uint32_t n, const SDL_FRect &f)
+					{
+						Slider::Attributes attr;
+						attr.rect = f;
+						attr.min_val = r.number(n, "min", 0.f);
+						attr.max_val = r.number(n, "max", 1.f);
+						attr.start_val = r.number(n, "value", attr.min_val);
+						attr.corner_radius = r.number(n, "corner-radius");
+						attr.bg_color = color(r.color(n, "bg", 0x323232ff));
+						attr.level_bar_color = color(r.color(n, "bar", 0xffffffff));
+						attr.knob_color = color(r.color(n, "knob", 0xffffffff));
+						attr.orientation = r.boolean(n, "vertical") ? Orientation::VERTICAL : Orientation::HORIZONTAL;
+						w.Build(c, std::move(attr)); });
+	}
+
+	std::unordered_map<Volt::StringId, Entry> entries_;
+};
+
+/*
+	A screen instantiated from a compiled UI description. load() maps the
+	blob (or reads it where mapping isn't possible), instantiate() lays the
+	nodes out and builds every widget in one sweep: each widget type gets a
+	single buffer sized from the blob's type table and widgets are placement
+	constructed into their slot, the ViewTree and layout are reserved up
+	front. Subtrees marked hidden cost nothing until show() builds them;
+	hide() takes a subtree out of the layout again but keeps its widgets.
+
+	The screen owns its views. Draw and route events through views(), call
+	update() with the new area on resize.
+	*/
+class UiScreen
+{
+public:
+	UiScreen() = default;
+	UiScreen(const UiScreen &) = delete;
+	UiScreen(UiScreen &&) = delete;
+
+	~UiScreen()
+	{
+		clear();
+	}
+
+	bool load(const std::string &_path)
+	{
+		clear();
+		if (mapped_.open(_path))
+			return open(mapped_.data(), mapped_.size(), _path);
+		// not mappable, eg. an Android asset
+		size_t size = 0;
+		void *data = SDL_LoadFile(_path.c_str(), &size);
+		if (data == nullptr)
+		{
+			GLogger.Log(Logger::Level::Error, "UiScreen::load cannot read", _path, SDL_GetError());
+			return false;
+		}
+		owned_.resize(size);
+		std::memcpy(owned_.data(), data, size);
+		SDL_free(data);
+		return open(owned_.data(), owned_.size(), _path);
+	}
+
+	bool loadMemory(std::vector<std::byte> _blob)
+	{
+		clear();
+		owned_ = std::move(_blob);
+		return open(owned_.data(), owned_.size(), "memory");
+	}
+
+	// compiles the text description in process, meant for iterating on a
+	// screen; ship the blob from the offline compiler
+	bool loadSource(std::string_view _source)
+	{
+		std::vector<std::byte> blob;
+		std::string error;
+		if (not UiBlob::Compiler{}.compile(_source, blob, &error))
+		{
+			clear();
+			GLogger.Log(Logger::Level::Error, "UiScreen::loadSource", error);
+			return false;
+		}
+		return loadMemory(std::move(blob));
+	}
+
+	UiScreen &instantiate(Context *_context, const SDL_FRect &_area)
+	{
+		VOLT_PROFILE_SCOPE("ui instantiate");
+		const Uint64 start = SDL_GetTicksNS();
+		destroyInstances();
+		context_ = _context;
+		area_ = _area;
+		const uint32_t count = blob_.nodeCount();
+		nodes_.assign(count, NodeState{});
+		pools_.assign(blob_.typeCount(), Pool{});
+		for (uint32_t t = 0; t < blob_.typeCount(); ++t)
+		{
+			Pool &pool = pools_[t];
+			pool.entry = UiWidgets::Get().find(blob_.typeName(t));
+			if (pool.entry and blob_.typeInstances(t) > 0)
+				pool.data = static_cast<std::byte *>(::operator new(pool.entry->size * blob_.typeInstances(t), std::align_val_t(pool.entry->align)));
+		}
+		views_.reserve(count);
+		layout_.reserve(count);
+		for (uint32_t i = 0; i < count; i = blob_.node(i).end)
+			if (not blob_.hidden(i))
+				materialize(i);
+		build_ns_ = SDL_GetTicksNS() - start;
+		return *this;
+	}
+
+	// builds the subtree first if it was deferred
+	bool show(const std::string &_name)
+	{
+		const uint32_t node = nodeOf(_name);
+		if (node == UiBlob::NoNode)
+			return false;
+		const uint32_t parent = blob_.node(node).parent;
+		if (parent != UiBlob::NoNode and nodes_[parent].layout == Layout::InvalidNode)
+		{
+			GLogger.Log(Logger::Level::Error, "UiScreen::show", _name, "is inside a hidden subtree");
+			return false;
+		}
+		if (nodes_[node].layout == Layout::InvalidNode)
+			materialize(node);
+		return true;
+	}
+
+	bool hide(const std::string &_name)
+	{
+		const uint32_t node = nodeOf(_name);
+		if (node == UiBlob::NoNode or nodes_[node].layout == Layout::InvalidNode)
+			return false;
+		layout_.remove(nodes_[node].layout);
+		for (uint32_t i = node; i < blob_.node(node).end; ++i)
+		{
+			nodes_[i].layout = Layout::InvalidNode;
+			if (nodes_[i].view)
+				views_.hideAndDisable(nodes_[i].handle);
+		}
+		layout_.update(area_);
+		return true;
+	}
+
+	bool isShown(const std::string &_name) const
+	{
+		const uint32_t node = nodeOf(_name);
+		return node != UiBlob::NoNode and nodes_[node].layout != Layout::InvalidNode;
+	}
+
+	// nullptr for unknown names, layout-only nodes and subtrees not built yet
+	IView *find(const std::string &_name) const
+	{
+		const uint32_t node = nodeOf(_name);
+		return node == UiBlob::NoNode ? nullptr : nodes_[node].view;
+	}
+
+	template <typename T>
+	T *find(const std::string &_name) const
+	{
+		return dynamic_cast<T *>(find(_name));
+	}
+
+	void update(const SDL_FRect &_area)
+	{
+		area_ = _area;
+		layout_.update(area_);
+	}
+
+	ViewTree &views() { return views_; }
+	ViewLayout &layout() { return layout_; }
+	const UiBlob::Reader &blob() const { return blob_; }
+
+	// time the last instantiate() took
+	Uint64 buildTimeNs() const { return build_ns_; }
+
+private:
+	struct NodeState
+	{
+		Layout::NodeId layout = Layout::InvalidNode;
+		IView *view = nullptr;
+		ViewHandle handle;
+		bool built = false;
+	};
+
+	struct Pool
+	{
+		const UiWidgets::Entry *entry = nullptr;
+		std::byte *data = nullptr;
+	};
+
+	bool open(const void *_data, size_t _size, const std::string &_what)
+	{
+		std::string error;
+		if (not blob_.open(_data, _size, &error))
+		{
+			GLogger.Log(Logger::Level::Error, "UiScreen: bad blob from", _what, error);
+			return false;
+		}
+		names_.clear();
+		names_.reserve(blob_.nodeCount());
+		for (uint32_t i = 0; i < blob_.nodeCount(); ++i)
+			if (not blob_.name(i).empty())
+				names_.emplace(blob_.name(i), i);
+		return true;
+	}
+
+	uint32_t nodeOf(const std::string &_name) const
+	{
+		auto it = names_.find(_name);
+		return it == names_.end() ? UiBlob::NoNode : it->second;
+	}
+
+	// Lays out and builds the subtree at _root, skipping nested hidden
+	// subtrees. Layout runs first so widgets are built at their final frame.
+	void materialize(uint32_t _root)
+	{
+		const uint32_t end = blob_.node(_root).end;
+		const UiBlob::NodeRec &root = blob_.node(_root);
+		const Layout::NodeId parent = root.parent == UiBlob::NoNode ? layout_.root() : nodes_[root.parent].layout;
+		// keep document order among the siblings that are already laid out
+		size_t index = 0;
+		for (uint32_t s = root.parent == UiBlob::NoNode ? 0 : root.parent + 1; s < _root; s = blob_.node(s).end)
+			if (nodes_[s].layout != Layout::InvalidNode)
+				++index;
+		for (uint32_t i = _root; i < end;)
+		{
+			if (i != _root and blob_.hidden(i))
+			{
+				i = blob_.node(i).end;
+				continue;
+			}
+			addLayoutNode(i, i == _root ? parent : nodes_[blob_.node(i).parent].layout, i == _root ? index : SIZE_MAX);
+			++i;
+		}
+		layout_.update(area_);
+		const SDL_FPoint origin{area_.x, area_.y};
+		for (uint32_t i = _root; i < end;)
+		{
+			NodeState &st = nodes_[i];
+			if (st.layout == Layout::InvalidNode)
+			{
+				i = blob_.node(i).end;
+				continue;
+			}
+			const Pool &pool = pools_[blob_.node(i).type];
+			if (pool.entry)
+			{
+				const Layout::Rect &r = layout_.tree().absoluteFrame(st.layout);
+				const SDL_FRect frame{origin.x + r.x, origin.y + r.y, r.w, r.h};
+				if (not st.built)
+				{
+					void *obj = pool.data + pool.entry->size * blob_.node(i).type_slot;
+					pool.entry->construct(obj);
+					st.built = true;
+					st.view = pool.entry->view(obj);
+					pool.entry->build(pool.entry->build_fn, obj, context_, blob_, i, frame);
+					if (not blob_.name(i).empty())
+					{
+						st.view->label = blob_.name(i);
+						st.handle = views_.addView(std::string(blob_.name(i)), st.view);
+					}
+					else
+						st.handle = views_.addView(st.view);
+				}
+				else
+				{
+					st.view->onLayout(frame);
+					views_.showAndEnable(st.handle);
+				}
+				layout_.bind(st.layout, st.view);
+			}
+			++i;
+		}
+	}
+
+	void addLayoutNode(uint32_t _node, Layout::NodeId _parent, size_t _index)
+	{
+		const Layout::Style style = blob_.style(_node);
+		const UiWidgets::Entry *entry = pools_[blob_.node(_node).type].entry;
+		Layout::NodeId id;
+		if (entry and entry->measure_text and (style.width.isAuto() or style.height.isAuto()))
+		{
+			FontAttributes font;
+			font.font_size = blob_.number(_node, "font-size", 16.f);
+			id = layout_.addText(_parent, style, std::string(blob_.text(_node, "text")), font);
+		}
+		else
+			id = layout_.add(_parent, style);
+		if (_index != SIZE_MAX)
+		{
+			// add() appended it, move it to its document position
+			layout_.tree().removeChild(_parent, id);
+			layout_.tree().insertChild(_parent, id, _index);
+		}
+		nodes_[_node].layout = id;
+	}
+
+	void clear()
+	{
+		destroyInstances();
+		names_.clear();
+		blob_ = UiBlob::Reader{};
+		mapped_.close();
+		owned_.clear();
+	}
+
+	void destroyInstances()
+	{
+		for (uint32_t i = 0; i < nodes_.size(); ++i)
+			if (nodes_[i].built)
+				views_.removeView(nodes_[i].handle);
+		for (uint32_t i = 0; i < nodes_.size(); ++i)
+			if (nodes_[i].built)
+			{
+				const Pool &pool = pools_[blob_.node(i).type];
+				pool.entry->destroy(pool.data + pool.entry->size * blob_.node(i).type_slot);
+			}
+		for (Pool &pool : pools_)
+			if (pool.data)
+				::operator delete(pool.data, std::align_val_t(pool.entry->align));
+		pools_.clear();
+		if (not nodes_.empty())
+			for (Layout::NodeId child : std::vector<Layout::NodeId>(layout_.tree().children(layout_.root())))
+				layout_.remove(child);
+		nodes_.clear();
+	}
+
+	UiBlob::Reader blob_;
+	UiBlob::MappedFile mapped_;
+	std::vector<std::byte> owned_;
+	// keys view into the blob
+	std::unordered_map<std::string_view, uint32_t> names_;
+	std::vector<NodeState> nodes_;
+	std::vector<Pool> pools_;
+	ViewTree views_;
+	ViewLayout layout_;
+	Context *context_ = nullptr;
+	SDL_FRect area_{0.f, 0.f, 0.f, 0.f};
+	Uint64 build_ns_ = 0;
+};
+
 void drawArcAntiAliased(SDL_Renderer *renderer, int centerX, int centerY, int radius, float startAngle, float endAngle, const SDL_Color &color)
 {
 	if (radius <= 0)
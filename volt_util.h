@@ -39,6 +39,9 @@
 #include <ctime>
 
 #include "utf8.h"
+#include "Profiler.hpp"
+#include "Clock.hpp"
+#include "FrameArena.hpp"
 
 
 
@@ -114,7 +117,8 @@ enum class IMAGE_LD_STYLE
 	ASYNC_PATH,
 	ASYNC_CUSTOM_SURFACE_LOADER,
 	ASYNC_DEFAULT_TEXTURE_PATH,
-	ASYNC_DEFAULT_TEXTURE_CUSTOM_LOADER
+	ASYNC_DEFAULT_TEXTURE_CUSTOM_LOADER,
+	ATLAS_REGION
 };
 
 enum class PixelSystem
@@ -854,7 +858,7 @@ class Logger
 	void Log(Logger::Level level, const Args &... _args)
 	{
 		auto msg = packToString(" ", _args...);
-		std::string sLevel = "Bad-Log";
+		const char *sLevel = "Bad-Log";
 		switch (level)
 		{
 			//using enum Logger::Level;
@@ -874,19 +878,22 @@ class Logger
 			break;
 		}
 		std::unique_lock<std::mutex> lock(this->queue_mutex);
-		std::string prefix = "[" + sLevel + "][" + getDateAndTimeStr() + "] ";
-		std::string finalMsg = prefix + msg;
-		if (last_log == prefix + msg)
+		// prefix and full line share one buffer
+		std::string finalMsg;
+		finalMsg.reserve(48 + msg.size());
+		finalMsg.append("[").append(sLevel).append("][").append(getDateAndTimeStr()).append("] ");
+		const std::size_t prefix_len = finalMsg.size();
+		finalMsg.append(msg);
+		if (last_log == finalMsg)
 		{
 				finalMsg = "...";
 		}
 		else {
-			if (last_log.contains(prefix)) {
-				finalMsg = "... " + msg;
-				last_log = prefix + msg;
+			if (last_log.contains(std::string_view(finalMsg).substr(0, prefix_len))) {
+				last_log = finalMsg;
+				finalMsg.replace(0, prefix_len, "... ");
 			}
 			else {
-				finalMsg = prefix + msg;
 				last_log = finalMsg;
 			}
 		}
@@ -997,6 +1004,182 @@ class Logger
 
 namespace Async
 {
+using TimerId = uint64_t;
+
+/*
+	Timers that fire on the UI thread. The event loop waits at most
+	msUntilNext() for input and then calls fireDue(), so a pending timer costs
+	no thread at all. Timers may be added or cancelled from any thread; adding
+	one that becomes the earliest from another thread runs the wake hook so
+	the loop recomputes its wait.
+	*/
+class TimerService
+{
+  public:
+
+	TimerService(const TimerService &) = delete;
+	TimerService(const TimerService &&) = delete;
+
+	static TimerService &Get()
+	{
+		static TimerService instance;
+		return instance;
+	}
+
+	// the thread that calls fireDue(), adds from it don't need a wake up
+	void bindToCurrentThread()
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		owner_ = std::this_thread::get_id();
+	}
+
+	void setWakeHook(std::function<void()> _hook)
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		wake_hook_ = std::move(_hook);
+	}
+
+	TimerId setTimeout(uint32_t _ms, std::function<void()> _func)
+	{
+		return add(_ms, 0, std::move(_func), nullptr);
+	}
+
+	// _keep_running is checked after every call, the timer stops once it returns false
+	TimerId setInterval(uint32_t _ms, std::function<void()> _func, std::function<bool()> _keep_running = nullptr)
+	{
+		return add(_ms, std::max<uint32_t>(1, _ms), std::move(_func), std::move(_keep_running));
+	}
+
+	void cancel(TimerId _id)
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		entries_.erase(_id);
+	}
+
+	bool isPending(TimerId _id) const
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		return entries_.contains(_id);
+	}
+
+	// ms until the earliest timer is due (rounded up), -1 when there is none
+	int32_t msUntilNext()
+	{
+		std::lock_guard<std::mutex> lock(mtx_);
+		dropStale();
+		if (heap_.empty())
+			return -1;
+		const uint64_t now = Volt::Clock::Get().sample();
+		if (heap_.front().due <= now)
+			return 0;
+		const uint64_t ms = (heap_.front().due - now + 999999) / 1000000;
+		return static_cast<int32_t>(std::min<uint64_t>(ms, INT32_MAX));
+	}
+
+	// runs every callback that is due, returns how many ran
+	size_t fireDue()
+	{
+		const uint64_t now = Volt::Clock::Get().sample();
+		std::vector<std::pair<TimerId, Entry>> due;
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			for (dropStale(); not heap_.empty() and heap_.front().due <= now; dropStale())
+			{
+				std::pop_heap(heap_.begin(), heap_.end(), Later{});
+				const TimerId id = heap_.back().id;
+				heap_.pop_back();
+				due.emplace_back(id, entries_.at(id));
+			}
+		}
+		// callbacks run unlocked so they can add or cancel timers
+		for (auto &[id, fired] : due)
+		{
+			if (fired.func)
+				fired.func();
+			const bool again = fired.interval_ms != 0 and (not fired.keep_running or fired.keep_running());
+			std::lock_guard<std::mutex> lock(mtx_);
+			auto it = entries_.find(id);
+			if (it == entries_.end())
+				continue;
+			auto &e = it->second;
+			if (not again)
+			{
+				entries_.erase(it);
+				continue;
+			}
+			// fixed rate, but never schedule into the past after a long stall
+			e.due = std::max<uint64_t>(e.due + e.interval_ms * 1000000ull, now);
+			heap_.push_back({e.due, id});
+			std::push_heap(heap_.begin(), heap_.end(), Later{});
+		}
+		return due.size();
+	}
+
+  private:
+	TimerService() = default;
+
+	// due times are Volt::Clock ns, so virtual time drives timers too
+	struct Entry
+	{
+		uint64_t due = 0;
+		uint32_t interval_ms = 0;
+		std::function<void()> func;
+		std::function<bool()> keep_running;
+	};
+
+	struct HeapNode
+	{
+		uint64_t due;
+		TimerId id;
+	};
+
+	struct Later
+	{
+		bool operator()(const HeapNode &_a, const HeapNode &_b) const { return _a.due > _b.due; }
+	};
+
+	TimerId add(uint32_t _ms, uint32_t _interval_ms, std::function<void()> _func, std::function<bool()> _keep_running)
+	{
+		std::function<void()> wake;
+		TimerId id = 0;
+		{
+			std::lock_guard<std::mutex> lock(mtx_);
+			id = ++last_id_;
+			const uint64_t due = Volt::Clock::Get().sample() + _ms * 1000000ull;
+			dropStale();
+			const bool earliest = heap_.empty() or due < heap_.front().due;
+			entries_[id] = {due, _interval_ms, std::move(_func), std::move(_keep_running)};
+			heap_.push_back({due, id});
+			std::push_heap(heap_.begin(), heap_.end(), Later{});
+			if (earliest and std::this_thread::get_id() != owner_)
+				wake = wake_hook_;
+		}
+		if (wake)
+			wake();
+		return id;
+	}
+
+	// cancelled timers are removed from the heap lazily
+	void dropStale()
+	{
+		while (not heap_.empty())
+		{
+			auto it = entries_.find(heap_.front().id);
+			if (it != entries_.end() and it->second.due == heap_.front().due)
+				return;
+			std::pop_heap(heap_.begin(), heap_.end(), Later{});
+			heap_.pop_back();
+		}
+	}
+
+	mutable std::mutex mtx_;
+	std::vector<HeapNode> heap_;
+	std::unordered_map<TimerId, Entry> entries_;
+	TimerId last_id_ = 0;
+	std::thread::id owner_{};
+	std::function<void()> wake_hook_ = nullptr;
+};
+
 class ThreadPool
 {
   public:
@@ -1009,6 +1192,12 @@ class ThreadPool
 		init(numThreads);
 	}
 
+	// workers are spawned by the first enqueue, an unused pool costs no threads
+	struct DeferStart {};
+	ThreadPool(size_t numThreads, DeferStart) : stop(false), deferred_threads(numThreads)
+	{
+	}
+
 	~ThreadPool()
 	{
 		kill_all();
@@ -1033,6 +1222,7 @@ class ThreadPool
 		for (size_t i = 0; i < numThreads; ++i)
 		{
 			workers.emplace_back([this] {
+                    VOLT_PROFILE_THREAD("pool worker");
                     while (true) {
                         std::function<void()> task;
                         {
@@ -1042,24 +1232,23 @@ class ThreadPool
                             task = std::move(this->tasks.front());
                             this->tasks.pop();
                         }
+                        VOLT_PROFILE_SCOPE("pool task");
                         task();
                     } });
 		}
 	}
 
+	// queues func_ on this pool every _interval ms until _stop_source returns
+	// true, the interval itself is kept by the UI-thread TimerService
 	template <class F, class... Args>
-	void runInterval(int _interval, std::function<bool()> _stop_source, F &&func_, Args &&... args)
+	TimerId runInterval(int _interval, std::function<bool()> _stop_source, F &&func_, Args &&... args)
 	{
-		using return_type = std::invoke_result_t<F, Args...>;
-		auto task = std::make_shared<std::packaged_task<return_type()>>(
+		auto task = std::make_shared<std::function<void()>>(
 			std::bind(std::forward<F>(func_), std::forward<Args>(args)...));
-		// clarity for this worker's lifetime is required to avoid potential dead locks
-		// should probably put the thread obj in a container like a que or a vector
-		// this needs to live until timeout or stop token invoke
-		std::thread intervalWorker([this, _interval, _stop_source] {
-                    while (not _stop_source()) {
-                        task();
-                    } });
+		return TimerService::Get().setInterval(
+			static_cast<uint32_t>(std::max(1, _interval)),
+			[this, task] { enqueue([task] { (*task)(); }); },
+			[_stop_source] { return not _stop_source(); });
 	}
 
 	template <class F, class... Args>
@@ -1074,6 +1263,8 @@ class ThreadPool
 			std::unique_lock<std::mutex> lock(queue_mutex);
 			if (stop)
 				throw std::runtime_error("enqueue on stopped thread pool");
+			if (workers.empty() && deferred_threads != 0)
+				init(deferred_threads);
 			tasks.emplace([task]() { (*task)(); });
 		}
 		condition.notify_one();
@@ -1108,18 +1299,13 @@ class ThreadPool
 	std::mutex queue_mutex;
 	std::condition_variable condition;
 	bool stop;
+	size_t deferred_threads = 0;
 };
 
-ThreadPool GThreadPool(std::thread::hardware_concurrency() + 4);
+ThreadPool GThreadPool(std::thread::hardware_concurrency() + 4, ThreadPool::DeferStart{});
 
 std::function<bool()> defaultTrue = []() { return true; };
 
-/// NOTES: should return a handler for the dispatched recuring task(the handler can be used for control like killing the task if not needed anymore)
-///  should have a lifetime param default = infinite(this param can be a lambda/functor that returns a boolean. the lambda is invoked after avery invoke
-// calls the given method after the given interval
-// param for number of iterations before termination
-// consider making the stop source param the result of the previous return
-
 /*template<class F, class... Args>
     void setInterval(int interval_, std::function<bool()> stop_source_,F&& func_, Args&&... args){
         using return_type = std::invoke_result_t<F, Args...>;
@@ -1129,21 +1315,11 @@ std::function<bool()> defaultTrue = []() { return true; };
             //task();
     }*/
 
-void setInterval(std::function<void(void)> func, unsigned int _interval, std::function<bool(void)> _stop_source = defaultTrue)
+// calls func on the UI thread every _interval ms for as long as _stop_source
+// keeps returning true, cancel early with TimerService::Get().cancel(id)
+inline TimerId setInterval(std::function<void(void)> func, unsigned int _interval, std::function<bool(void)> _stop_source = defaultTrue)
 {
-	/*std::thread(func, interval, stopSource {
-            while (!stopSource()) {
-                func();
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-            }
-        }).detach();*/
-
-	/*std::thread intervalWorker([func, _interval, _stop_source] {
-            while (_stop_source()) {
-                func();
-                std::this_thread::sleep_for(std::chrono::milliseconds(_interval));
-            }
-        }).detach();*/
+	return TimerService::Get().setInterval(_interval, std::move(func), std::move(_stop_source));
 }
 
 }; // namespace Async
@@ -2435,6 +2611,8 @@ class FileStore
 	{
 		std::deque<std::filesystem::path> local_files;
 		std::unordered_map<std::string, int> local_extensions;
+		// reused for every directory, keeps its capacity
+		std::vector<std::filesystem::path> sub_dirs;
 		PathTask current_task;
 		const size_t BATCH_SIZE = 1000;
 
@@ -2456,7 +2634,7 @@ class FileStore
 
 			dir_count++;
 			struct dirent *entry;
-			std::vector<std::filesystem::path> sub_dirs;
+			sub_dirs.clear();
 
 			while ((entry = readdir(dir)) != nullptr)
 			{
@@ -2509,10 +2687,10 @@ class FileStore
 			closedir(dir);
 
 			size_t next_depth = current_depth + 1;
-			for (const auto &sub_dir : sub_dirs)
+			for (auto &sub_dir : sub_dirs)
 			{
 				tasks_pending++;
-				dir_queue.push({sub_dir, next_depth});
+				dir_queue.push({std::move(sub_dir), next_depth});
 			}
 
 			if (local_files.size() >= BATCH_SIZE)
@@ -2533,6 +2711,8 @@ class FileStore
 	{
 		std::deque<std::filesystem::path> local_files;
 		std::unordered_map<std::string, int> local_extensions;
+		// reused for every directory, keeps its capacity
+		std::vector<std::filesystem::path> sub_dirs;
 		PathTask current_task;
 		const size_t BATCH_SIZE = 200;
 
@@ -2555,7 +2735,7 @@ class FileStore
 			}
 
 			dir_count++;
-			std::vector<std::filesystem::path> sub_dirs;
+			sub_dirs.clear();
 
 			for (const auto &entry : dir_iter)
 			{
@@ -2590,10 +2770,10 @@ class FileStore
 			}
 
 			size_t next_depth = current_depth + 1;
-			for (const auto &sub_dir : sub_dirs)
+			for (auto &sub_dir : sub_dirs)
 			{
 				tasks_pending++;
-				dir_queue.push({sub_dir, next_depth});
+				dir_queue.push({std::move(sub_dir), next_depth});
 			}
 
 			if (local_files.size() >= BATCH_SIZE)